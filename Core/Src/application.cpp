@@ -1,8 +1,8 @@
 #include "application.h"
 #include "l3g4200d.h"
+#include "shake_detect.h"
 #include "csp/csp4cmsis.h"
 #include <cstdio>
-#include <cmath>
 extern "C" {
 #include "main.h"
 #include "cmsis_os.h"
@@ -12,39 +12,83 @@ extern "C" {
 #define GYRO_INT1_PIN GPIO_PIN_1
 extern SPI_HandleTypeDef hspi3;
 
+// 1: gyro and shake detection fused into one task (no channel between them).
+// 0: one process per stage, connected by msg_chan; ShakeDetect takes a whole
+//    analysis window per wake-up.
+#define APP_FUSED_FRONT_END 1
+
+// Split front end only. 1: sensor path above the UI (Prio<> in MainApp_Task);
+// 0: the old network, where ShakeDetect shares the default priority with UI,
+// for comparing DRDY-to-detect jitter.
+#define APP_PRIORITISED_NETWORK 1
+
 using namespace csp;
 
-struct trigger_t {};
+// DWT cycle count taken in the DRDY interrupt, carried with the sample.
+struct trigger_t {
+	uint32_t drdy_cycles;
+};
 static Channel<trigger_t> g_trigger_chan;
 
-struct Message {
-	float x,y,z;
+// Other interrupt sources post tagged events into one lock-free ring; IrqMonitor drains it.
+enum IrqSource : uint8_t {
+	IRQ_BUTTON,     // B1, EXTI15_10
 };
-
-struct Result {
-	float result;
+struct IrqEvent {
+	uint8_t source;
+	uint32_t cycles;
+};
+using IrqChannel = IsrEventChannel<IrqEvent, 8>;
+static IrqChannel g_irq_events;
+
+// DRDY interrupt to ShakeDetect receiving the sample, in CPU cycles.
+struct LatencyStats {
+	uint32_t min_cycles;
+	uint32_t max_cycles;
+	uint64_t sum_cycles;
+	uint32_t count;
 };
+static LatencyStats g_drdy_latency = { UINT32_MAX, 0, 0, 0 };
+
+static void latency_record(uint32_t cycles) {
+	taskENTER_CRITICAL();
+	if (cycles < g_drdy_latency.min_cycles) g_drdy_latency.min_cycles = cycles;
+	if (cycles > g_drdy_latency.max_cycles) g_drdy_latency.max_cycles = cycles;
+	g_drdy_latency.sum_cycles += cycles;
+	g_drdy_latency.count++;
+	taskEXIT_CRITICAL();
+}
+
+// ShakeDetect's per-sample hook: the sample has reached the detector.
+static void record_drdy_latency(const Message& msg) {
+	latency_record(DWT->CYCCNT - msg.drdy_cycles);
+}
+
+// Each shake-state change goes to UI and ShakeLed; the detector waits for both.
+using ResultChannel = BroadcastChannel<Result, 2>;
 
 extern "C" void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
     if (GPIO_Pin == GYRO_INT1_PIN) {
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        g_trigger_chan.writer().putFromISR(trigger_t{});
+        g_trigger_chan.writer().putFromISR(trigger_t{ DWT->CYCCNT });
         // This forces a context switch if the Receiver task has higher priority
         portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    } else if (GPIO_Pin == B1_Pin) {
+        g_irq_events.writer().putFromISR(IrqEvent{ IRQ_BUTTON, DWT->CYCCNT });
     }
 }
 
-class L3g4200d : public CSProcess {
+// Stage: reads the gyro for every DRDY trigger.
+class L3g4200d {
 private:
-	Chanout<Message> out;
+    L3G4200D_t gyro;
+
 public:
-	L3g4200d(Chanout<Message> w) : out(w) {}
+	static constexpr bool isr_fed = true;   // woken by the DRDY interrupt
+	static constexpr uint32_t stall_ms = 50;  // no DRDY for 5 sample periods: sensor stalled
 
-    void run() override {
-    	trigger_t t;
-    	auto trigger_reader = g_trigger_chan.reader();
+    bool start() {
         vTaskDelay(pdMS_TO_TICKS(10));
-        L3G4200D_t gyro;
 
         gyro.hspi = &hspi3;
         gyro.cs_port = GPIOB;
@@ -55,102 +99,152 @@ public:
         }
         if (HAL_ERROR == L3G4200D_EnableINT1(&gyro)){
         	printf("HAL-ERROR during INT1 enable\r\n");
-        	return;
+        	return false;
         }
 
         Message msg;
         L3G4200D_ReadDPS(&gyro, &msg.x, &msg.y, &msg.z);
-        while(true) {
-        	trigger_reader >> t;
-			L3G4200D_ReadDPS(&gyro, &msg.x, &msg.y, &msg.z);
-			out << msg;
-        }
+        return true;
+    }
+
+    // Watchdog: a missed DRDY edge leaves INT1 latched high and the EXTI never
+    // fires again. Reading the output registers clears the latch.
+    bool stalled() {
+        printf("WARNING: gyro stalled, re-arming DRDY\r\n");
+        Message msg;
+        L3G4200D_ReadDPS(&gyro, &msg.x, &msg.y, &msg.z);
+        return true;
+    }
+
+    bool operator()(const trigger_t& t, Message& msg) {
+		L3G4200D_ReadDPS(&gyro, &msg.x, &msg.y, &msg.z);
+		msg.drdy_cycles = t.drdy_cycles;
+		return true;
     }
 };
 
-class ShakeDetect : public CSProcess {
+// Split front end: samples are buffered between the gyro and ShakeDetect.
+using MsgChannel = BufferedOne2OneChannel<Message, 2 * ShakeDetect::window_size>;
+
+/**
+ * Runs ShakeDetect over one analysis window per wake-up instead of one per sample.
+ * Early samples of a window wait for the rest, which shows up in the latency figures.
+ */
+class ShakeWindow : public CSProcessWithStack<256> {
 private:
-    Chanin<Message> in;
-    Chanout<Result> out;
+    MsgChannel::Reader in;
+    ShakeDetect& shake;
+    ResultChannel::Writer out;
 
 public:
-    ShakeDetect(Chanin<Message> r, Chanout<Result> w)
-        : in(r), out(w) {}
+    ShakeWindow(MsgChannel::Reader r, ShakeDetect& s, ResultChannel::Writer w) : in(r), shake(s), out(w) {}
 
     void run() override {
+        Message window[ShakeDetect::window_size];
+        Result res;
 
-        const float alpha = 0.02f;          // mean filter speed
-        const int window_size = 10;         // ~100ms if 100Hz
-        const float threshold_on  = 3000.0f;
-        const float threshold_off = 1500.0f;
+        while (true) {
+            size_t n = in.read(window);
+            for (size_t i = 0; i < n; i++) {
+                if (shake(window[i], res)) out << res;
+            }
+        }
+    }
+};
 
-        float mean = 0.0f;
-        float energy = 0.0f;
-        int count = 0;
+class UI : public CSProcessWithStack<512> {   // printf needs the headroom
+private:
+    ResultChannel::Reader in;
 
-        bool shake_state = false;
+public:
+    UI(ResultChannel::Reader r) : in(r) {}
 
-        Message msg;
-        Result result;
+    void run() override {
 
-        while (true) {
+        Result res;
 
-            in >> msg;
+        while (true) {
+            in >> res;
 
-            // --- 1. Magnitude ---
-            float mag = sqrtf(msg.x*msg.x +
-                              msg.y*msg.y +
-                              msg.z*msg.z);
+            if (res.result > 0.5f) {
+                printf(">>> SHAKE DETECTED! <<<\r\n");
+            } else {
+                printf("Shake ended.\r\n");
+            }
+        }
+    }
+};
 
-            // --- 2. High-pass via running mean ---
-            mean += alpha * (mag - mean);
-            float hp = mag - mean;
+/**
+ * Mirrors the shake state on LD2. A second subscriber of the result broadcast,
+ * so it sees every change UI does.
+ */
+class ShakeLed : public CSProcessWithStack<128> {
+private:
+    ResultChannel::Reader in;
 
-            // --- 3. Accumulate energy ---
-            energy += hp * hp;
-            count++;
+public:
+    ShakeLed(ResultChannel::Reader r) : in(r) {}
 
-            if (count >= window_size) {
+    void run() override {
+        Result res;
 
-                float avg_energy = energy / count;
+        while (true) {
+            in >> res;
+            HAL_GPIO_WritePin(LD2_GPIO_Port, LD2_Pin, res.result > 0.5f ? GPIO_PIN_SET : GPIO_PIN_RESET);
+        }
+    }
+};
 
-                // --- 4. Hysteresis detection ---
-                if (!shake_state && avg_energy > threshold_on) {
-                    shake_state = true;
-                    result.result = 1.0f;
-                    out << result;
-                }
-                else if (shake_state && avg_energy < threshold_off) {
-                    shake_state = false;
-                    result.result = 0.0f;
-                    out << result;
-                }
+/**
+ * Prints the DRDY-to-detect latency once a second. Its printf traffic shares the
+ * UART with UI, so it is also the UI load the sensor path has to ride over.
+ */
+class LatencyMonitor : public CSProcessWithStack<512> {
+public:
+    void run() override {
+        const float us_per_cycle = 1e6f / (float)SystemCoreClock;
 
-                energy = 0.0f;
-                count = 0;
-            }
+        while (true) {
+            vTaskDelay(pdMS_TO_TICKS(1000));
+
+            taskENTER_CRITICAL();
+            LatencyStats s = g_drdy_latency;
+            g_drdy_latency = { UINT32_MAX, 0, 0, 0 };
+            taskEXIT_CRITICAL();
+
+            if (s.count == 0) continue;
+            printf("DRDY->detect: n=%lu min=%.1fus mean=%.1fus max=%.1fus jitter=%.1fus\r\n",
+                   (unsigned long)s.count,
+                   s.min_cycles * us_per_cycle,
+                   (float)(s.sum_cycles / s.count) * us_per_cycle,
+                   s.max_cycles * us_per_cycle,
+                   (s.max_cycles - s.min_cycles) * us_per_cycle);
         }
     }
 };
 
-class UI : public CSProcess {
+/**
+ * Takes the interrupt events a batch at a time. B1 prints the ring's high-water
+ * mark, to check the headroom left for more sources on the board.
+ */
+class IrqMonitor : public CSProcessWithStack<512> {
 private:
-    Chanin<Result> in;
+    IrqChannel::Reader in;
 
 public:
-    UI(Chanin<Result> r) : in(r) {}
+    IrqMonitor(IrqChannel::Reader r) : in(r) {}
 
     void run() override {
-
-        Result res;
+        IrqEvent batch[8];
 
         while (true) {
-            in >> res;
-
-            if (res.result > 0.5f) {
-                printf(">>> SHAKE DETECTED! <<<\r\n");
-            } else {
-                printf("Shake ended.\r\n");
+            size_t n = in.read(batch);
+            for (size_t i = 0; i < n; i++) {
+                if (batch[i].source == IRQ_BUTTON) {
+                    printf("B1: irq ring max depth %lu, overflows %lu\r\n",
+                           (unsigned long)in.maxDepth(), (unsigned long)in.overflows());
+                }
             }
         }
     }
@@ -159,25 +253,59 @@ public:
 void MainApp_Task(void* params) {
     vTaskDelay(pdMS_TO_TICKS(10));
 
+    // Cycle counter for the latency timestamps.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     printf("\r\n--- Launching CSP Static Network (Zero-Heap) ---\r\n");
 
-    static Channel<Message>  msg_chan;      // unbuffered – can be buffered if needed
-    static Channel<Result> result_chan;
+    static ResultChannel result_chan;
 
-    static L3g4200d pL3g4200d(msg_chan.writer());
-    static ShakeDetect pShakeDetect(msg_chan.reader(), result_chan.writer());
-    static UI pUI(result_chan.reader());
+    static L3g4200d gyro;
+    static ShakeDetect shake(3000.0f, 1500.0f, record_drdy_latency);
+    static UI pUI(result_chan.reader(0));
+    static ShakeLed pLed(result_chan.reader(1));
+    static LatencyMonitor pLatency;
+    static IrqMonitor pIrq(g_irq_events.reader());
 
     // Run parallel processes using static execution
+#if APP_FUSED_FRONT_END
+    static auto pFrontEnd = Fuse(g_trigger_chan.reader(), gyro, shake, result_chan.writer());
+
     Run(
-        InParallel(pL3g4200d, pShakeDetect, pUI),
+        InParallel(Prio<5>(pFrontEnd), pUI, pLed, pLatency, pIrq),
         ExecutionMode::StaticNetwork
     );
+#else
+    static MsgChannel msg_chan;
+
+    static auto pL3g4200d = Fuse(g_trigger_chan.reader(), gyro, msg_chan.writer());
+    static ShakeWindow pShakeDetect(msg_chan.reader(), shake, result_chan.writer());
+
+#if APP_PRIORITISED_NETWORK
+    Run(
+        InParallel(Prio<5>(pL3g4200d), Prio<4>(pShakeDetect), pUI, pLed, pLatency, pIrq),
+        ExecutionMode::StaticNetwork
+    );
+#else
+    Run(
+        InParallel(pL3g4200d, pShakeDetect, pUI, pLed, pLatency, pIrq),
+        ExecutionMode::StaticNetwork
+    );
+#endif
+#endif
 }
 
+// MainApp_Task ends up running the first process of the network (the gyro front end) on this stack.
+#define MAIN_APP_STACK_WORDS 2048
+static StaticTask_t main_app_tcb;
+static StackType_t main_app_stack[MAIN_APP_STACK_WORDS];
+
 void csp_app_main_init(void) {
-	BaseType_t status = xTaskCreate(MainApp_Task, "MainApp", 2048, NULL, tskIDLE_PRIORITY + 3, NULL);
-	if (status != pdPASS) {
+	TaskHandle_t handle = xTaskCreateStatic(MainApp_Task, "MainApp", MAIN_APP_STACK_WORDS, NULL,
+	                                        tskIDLE_PRIORITY + 3, main_app_stack, &main_app_tcb);
+	if (handle == NULL) {
 	    printf("ERROR: MainApp_Task creation failed!\r\n");
 	}
 }
@@ -356,6 +356,10 @@ static void MX_GPIO_Init(void)
   // 4. Enable the interrupt line
   HAL_NVIC_EnableIRQ(EXTI1_IRQn);
 
+  // B1 (PC13, falling edge above) posts into the application's interrupt event ring
+  HAL_NVIC_SetPriority(EXTI15_10_IRQn, 6, 0);
+  HAL_NVIC_EnableIRQ(EXTI15_10_IRQn);
+
   /* USER CODE END MX_GPIO_Init_2 */
 }
 
@@ -0,0 +1,85 @@
+/*
+ * shake_detect.h
+ *
+ * The shake detector, free of HAL and board code so that it also builds on the
+ * host (lib/CSP4CMSIS/examples/host_pipelines.cpp). The board ties in through
+ * the per-sample hook, which application.cpp uses for the DRDY latency figures.
+ */
+
+#ifndef SRC_SHAKE_DETECT_H_
+#define SRC_SHAKE_DETECT_H_
+
+#include <stdint.h>
+#include <cmath>
+
+struct Message {
+	float x,y,z;
+	uint32_t drdy_cycles;
+};
+
+struct Result {
+	float result;
+};
+
+// Stage: emits a Result when the shake state changes.
+class ShakeDetect {
+public:
+    static constexpr int window_size = 10;         // ~100ms if 100Hz
+
+    // Called with every sample as it arrives, before it is filtered.
+    using SampleHook = void (*)(const Message& msg);
+
+private:
+    static constexpr float alpha = 0.02f;          // mean filter speed
+    float threshold_on;
+    float threshold_off;
+    SampleHook on_sample;
+
+    float mean = 0.0f;
+    float energy = 0.0f;
+    int count = 0;
+
+    bool shake_state = false;
+
+public:
+    explicit ShakeDetect(float on = 3000.0f, float off = 1500.0f, SampleHook hook = nullptr)
+        : threshold_on(on), threshold_off(off), on_sample(hook) {}
+
+    bool operator()(const Message& msg, Result& result) {
+        if (on_sample != nullptr) on_sample(msg);
+
+        // --- 1. Magnitude ---
+        float mag = sqrtf(msg.x*msg.x +
+                          msg.y*msg.y +
+                          msg.z*msg.z);
+
+        // --- 2. High-pass via running mean ---
+        mean += alpha * (mag - mean);
+        float hp = mag - mean;
+
+        // --- 3. Accumulate energy ---
+        energy += hp * hp;
+        count++;
+
+        if (count < window_size) return false;
+
+        float avg_energy = energy / count;
+        energy = 0.0f;
+        count = 0;
+
+        // --- 4. Hysteresis detection ---
+        if (!shake_state && avg_energy > threshold_on) {
+            shake_state = true;
+            result.result = 1.0f;
+            return true;
+        }
+        if (shake_state && avg_energy < threshold_off) {
+            shake_state = false;
+            result.result = 0.0f;
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif /* SRC_SHAKE_DETECT_H_ */
@@ -0,0 +1,304 @@
+// --- host_bench.cpp ---
+// Channel benchmark suite for the host build (port/host). Each measurement is
+// one JSON object per line on stdout, so runs can be stored and compared:
+//
+//     ./csp_bench > before.jsonl      ...      ./csp_bench > after.jsonl
+//
+// Measured:
+//   handoff   hand-offs/s and send-to-receive latency percentiles for the
+//             rendezvous, buffered and overwriting (lossy) channels
+//   alt       cost of one select against the number of guards, Alternative
+//             and PersistentAlternative
+//   barrier   completed phases/s for 2 to 8 processes
+//   isr       putFromISR injection from a simulated interrupt into an
+//             IsrEventChannel and a buffered channel: events/s, latency, rejections
+//
+// --quick runs a tenth of the iterations.
+
+#include "csp/csp4cmsis.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace csp;
+
+// --- Configuration ---
+#define HANDOFF_ROUNDS 200000u
+#define ALT_ROUNDS 200000u
+#define BARRIER_ROUNDS 20000u
+#define ISR_EVENTS 200000u
+
+static uint32_t scale = 1;   // iteration divisor, 10 with --quick
+
+static uint32_t rounds(uint32_t full) { return full / scale; }
+
+static uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// What every timed hand-off carries: a sequence number and its send time.
+struct Stamp {
+    uint32_t seq;
+    uint64_t sent_ns;
+};
+
+// Send-to-receive latencies of one run.
+class LatencyLog {
+private:
+    std::vector<uint32_t> samples;
+public:
+    void reset(uint32_t expected) {
+        samples.clear();
+        samples.reserve(expected);
+    }
+
+    void record(const Stamp& s) { samples.push_back((uint32_t)(nowNs() - s.sent_ns)); }
+
+    size_t count() const { return samples.size(); }
+
+    // Prints ,"p50_ns":..,"max_ns":.. for the samples so far.
+    void printPercentiles() {
+        if (samples.empty()) return;
+        std::sort(samples.begin(), samples.end());
+        auto at = [this](double p) { return samples[(size_t)(p * (double)(samples.size() - 1))]; };
+        printf(",\"p50_ns\":%u,\"p90_ns\":%u,\"p99_ns\":%u,\"p999_ns\":%u,\"max_ns\":%u",
+               at(0.50), at(0.90), at(0.99), at(0.999), samples.back());
+    }
+};
+
+// =============================================================
+//  handoff: one writer, one reader
+// =============================================================
+
+template <typename Out>
+class StampWriter : public CSProcess {
+private:
+    Out out;
+    uint32_t n = 0;
+public:
+    StampWriter(Out w) : out(w) {}
+    void start(uint32_t count) { n = count; }
+
+    void run() override {
+        for (uint32_t i = 0; i < n; ++i) out << Stamp{ i, nowNs() };
+    }
+};
+
+// Reads until the last sequence number: every one of them on a lossless
+// channel, the ones not overwritten on a lossy one.
+template <typename In>
+class StampReader : public CSProcess {
+private:
+    In in;
+    uint32_t n = 0;
+public:
+    LatencyLog latency;
+
+    StampReader(In r) : in(r) {}
+    void start(uint32_t count) { n = count; latency.reset(count); }
+
+    void run() override {
+        Stamp s;
+        do {
+            in >> s;
+            latency.record(s);
+        } while (s.seq + 1 < n);
+    }
+};
+
+template <typename Chan>
+static void benchHandoff(const char* kind, Chan& chan) {
+    static StampWriter<typename Chan::Writer> writer(chan.writer());
+    static StampReader<typename Chan::Reader> reader(chan.reader());
+
+    const uint32_t n = rounds(HANDOFF_ROUNDS);
+    writer.start(n);
+    reader.start(n);
+
+    const uint64_t start = nowNs();
+    Run(InParallel(reader, writer));
+    const double seconds = (double)(nowNs() - start) / 1e9;
+
+    printf("{\"bench\":\"handoff\",\"channel\":\"%s\",\"sent\":%u,\"received\":%zu,\"handoffs_per_s\":%.0f",
+           kind, n, reader.latency.count(), (double)reader.latency.count() / seconds);
+    reader.latency.printPercentiles();
+    printf("}\n");
+}
+
+// =============================================================
+//  alt: select cost against guard count
+// =============================================================
+
+#define ALT_MAX_GUARDS 64
+
+static BufferedOne2OneChannel<uint32_t, 1> alt_chans[ALT_MAX_GUARDS];
+static uint32_t alt_values[ALT_MAX_GUARDS];
+
+// The last guard is the ready one, so every select looks at all of them.
+template <typename Alt>
+static void benchSelect(const char* kind, Alt& alt, size_t guards) {
+    auto out = alt_chans[guards - 1].writer();
+    const uint32_t n = rounds(ALT_ROUNDS);
+
+    const uint64_t start = nowNs();
+    for (uint32_t r = 0; r < n; ++r) {
+        out << r;
+        alt.priSelect();
+    }
+    const uint64_t elapsed = nowNs() - start;
+
+    printf("{\"bench\":\"alt\",\"alt\":\"%s\",\"guards\":%zu,\"selects\":%u,\"ns_per_select\":%.1f}\n",
+           kind, guards, n, (double)elapsed / n);
+}
+
+static void benchAlt() {
+    for (size_t guards = 1; guards <= 16; guards *= 2) {
+        Alternative alt;
+        for (size_t i = 0; i < guards; ++i) {
+            auto in = alt_chans[i].reader();
+            alt.addBinding(in | alt_values[i]);
+        }
+        benchSelect("Alternative", alt, guards);
+    }
+    for (size_t guards = 1; guards <= ALT_MAX_GUARDS; guards *= 2) {
+        PersistentAlternative<ALT_MAX_GUARDS> alt;
+        for (size_t i = 0; i < guards; ++i) {
+            auto in = alt_chans[i].reader();
+            alt.addBinding(in | alt_values[i]);
+        }
+        benchSelect("PersistentAlternative", alt, guards);
+    }
+}
+
+// =============================================================
+//  barrier: phases/s
+// =============================================================
+
+class BarrierMember : public CSProcess {
+private:
+    Barrier* barrier = nullptr;
+    uint32_t n = 0;
+public:
+    void start(Barrier& b, uint32_t count) { barrier = &b; n = count; }
+
+    void run() override {
+        for (uint32_t r = 0; r < n; ++r) barrier->sync();
+    }
+};
+
+template <size_t... I>
+static void benchBarrier(std::index_sequence<I...>) {
+    constexpr size_t procs = sizeof...(I);
+    static Barrier barrier(procs);
+    static BarrierMember members[procs];
+
+    const uint32_t n = rounds(BARRIER_ROUNDS);
+    for (BarrierMember& m : members) m.start(barrier, n);
+
+    const uint64_t start = nowNs();
+    Run(InParallel(members[I]...));
+    const double seconds = (double)(nowNs() - start) / 1e9;
+
+    printf("{\"bench\":\"barrier\",\"processes\":%zu,\"phases\":%u,\"phases_per_s\":%.0f}\n",
+           procs, n, (double)n / seconds);
+}
+
+// =============================================================
+//  isr: putFromISR injection
+// =============================================================
+
+// Plays an interrupt that fires back to back: each event goes in with
+// putFromISR(), retried while the channel is full and counted as rejected.
+template <typename Out>
+class IsrInjector : public CSProcess {
+private:
+    Out out;
+    uint32_t n = 0;
+
+    static void handler(void* self) {
+        IsrInjector* me = static_cast<IsrInjector*>(self);
+        for (uint32_t i = 0; i < me->n; ++i) {
+            while (!me->out.putFromISR(Stamp{ i, nowNs() })) {
+                me->rejected++;
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    uint32_t rejected = 0;
+
+    IsrInjector(Out w) : out(w) {}
+    void start(uint32_t count) { n = count; rejected = 0; }
+
+    void run() override { vPortRunAsInterrupt(handler, this); }
+};
+
+template <typename Chan>
+static void benchIsr(const char* kind, Chan& chan) {
+    static IsrInjector<typename Chan::Writer> injector(chan.writer());
+    static StampReader<typename Chan::Reader> reader(chan.reader());
+
+    const uint32_t n = rounds(ISR_EVENTS);
+    injector.start(n);
+    reader.start(n);
+
+    const uint64_t start = nowNs();
+    Run(InParallel(reader, injector));
+    const double seconds = (double)(nowNs() - start) / 1e9;
+
+    printf("{\"bench\":\"isr\",\"channel\":\"%s\",\"events\":%u,\"rejected\":%u,\"events_per_s\":%.0f",
+           kind, n, injector.rejected, (double)n / seconds);
+    reader.latency.printPercentiles();
+    printf("}\n");
+}
+
+// =============================================================
+
+static bool selected(int argc, char** argv, const char* bench) {
+    bool any_filter = false;
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i][0] == '-') continue;
+        any_filter = true;
+        if (std::strcmp(argv[i], bench) == 0) return true;
+    }
+    return !any_filter;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) scale = 10;
+    }
+
+    printf("{\"bench\":\"host\",\"port\":\"std::thread\",\"hardware_threads\":%u,\"quick\":%s}\n",
+           std::thread::hardware_concurrency(), scale > 1 ? "true" : "false");
+
+    if (selected(argc, argv, "handoff")) {
+        static Channel<Stamp> rendezvous;
+        static BufferedOne2OneChannel<Stamp, 16> buffered;
+        static LossyOne2OneChannel<Stamp, 16> lossy;
+        benchHandoff("rendezvous", rendezvous);
+        benchHandoff("buffered", buffered);
+        benchHandoff("overwriting", lossy);
+    }
+    if (selected(argc, argv, "alt")) {
+        benchAlt();
+    }
+    if (selected(argc, argv, "barrier")) {
+        benchBarrier(std::make_index_sequence<2>());
+        benchBarrier(std::make_index_sequence<4>());
+        benchBarrier(std::make_index_sequence<8>());
+    }
+    if (selected(argc, argv, "isr")) {
+        static IsrEventChannel<Stamp, 64> events;
+        static BufferedOne2OneChannel<Stamp, 64> queued;
+        benchIsr("isr_event", events);
+        benchIsr("buffered", queued);
+    }
+    return 0;
+}
@@ -0,0 +1,156 @@
+// --- host_pipelines.cpp ---
+// Shake detection over a recorded gyro trace on the std::thread port (port/host):
+// one independent source -> detector -> tally pipeline per on-threshold of the
+// board's ShakeDetect (Core/Src/shake_detect.h), run with 1, 2, 4, ... pipelines
+// in parallel. Reports blocks/s and the speed-up over one pipeline, which should
+// follow the number of cores.
+
+#include "csp/csp4cmsis.h"
+#include "shake_detect.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <utility>
+
+using namespace csp;
+
+// --- Configuration ---
+#define TRACE_SAMPLES (1u << 18)
+#define BLOCK_SAMPLES 4096u
+#define BLOCKS_PER_PIPELINE 2048
+#define MAX_PIPELINES 16
+
+#define END_OF_TRACE (-1)
+
+// The recording every pipeline reads; blocks travel as indices into it.
+static Message trace[TRACE_SAMPLES];
+
+// Noise around a slow drift, with a shake burst every 8192 samples.
+static void recordTrace() {
+    uint32_t lcg = 12345;
+    for (uint32_t i = 0; i < TRACE_SAMPLES; ++i) {
+        lcg = lcg * 1664525u + 1013904223u;
+        const float noise = (float)(lcg >> 16) / 65536.0f - 0.5f;
+        const bool shaking = (i % 8192u) < 1024u;
+        const float swing = shaking ? 400.0f * sinf((float)i * 0.7f) : 0.0f;
+        trace[i] = Message{ 20.0f + 30.0f * noise + swing, -5.0f + swing, 10.0f * noise, 0 };
+    }
+}
+
+class BlockSource : public CSProcessWithStack<128> {
+private:
+    Chanout<int> out;
+public:
+    BlockSource(Chanout<int> w) : out(w) {}
+
+    void run() override {
+        const int blocks_in_trace = (int)(TRACE_SAMPLES / BLOCK_SAMPLES);
+        for (int b = 0; b < BLOCKS_PER_PIPELINE; ++b) out << b % blocks_in_trace;
+        out << END_OF_TRACE;
+    }
+};
+
+// Runs a fresh ShakeDetect with the given on-threshold (the board's off-threshold)
+// over each run: counts shake onsets per block.
+class ShakeSweep : public CSProcessWithStack<128> {
+private:
+    Chanin<int> in;
+    Chanout<int> out;
+    float threshold_on = 3000.0f;
+
+    static int onsets(ShakeDetect& detect, const Message* s) {
+        int n = 0;
+        Result res;
+        for (uint32_t i = 0; i < BLOCK_SAMPLES; ++i) {
+            if (detect(s[i], res) && res.result > 0.5f) n++;
+        }
+        return n;
+    }
+
+public:
+    ShakeSweep(Chanin<int> r, Chanout<int> w) : in(r), out(w) {}
+
+    void setThreshold(float t) { threshold_on = t; }
+
+    void run() override {
+        ShakeDetect detect(threshold_on);
+
+        int block;
+        while (true) {
+            in >> block;
+            if (block == END_OF_TRACE) break;
+            out << onsets(detect, &trace[(uint32_t)block * BLOCK_SAMPLES]);
+        }
+        out << END_OF_TRACE;
+    }
+};
+
+class Tally : public CSProcessWithStack<128> {
+private:
+    Chanin<int> in;
+public:
+    long shakes = 0;
+
+    Tally(Chanin<int> r) : in(r) {}
+
+    void run() override {
+        shakes = 0;
+        int n;
+        while (true) {
+            in >> n;
+            if (n == END_OF_TRACE) break;
+            shakes += n;
+        }
+    }
+};
+
+struct Pipeline {
+    Channel<int> blocks;
+    Channel<int> counts;
+    BlockSource source;
+    ShakeSweep detector;
+    Tally tally;
+
+    Pipeline() : source(blocks.writer()), detector(blocks.reader(), counts.writer()), tally(counts.reader()) {}
+};
+
+static Pipeline pipelines[MAX_PIPELINES];
+
+// One network of P pipelines; the first tally runs on the calling thread.
+template <size_t... I>
+static void runPipelines(std::index_sequence<I...>) {
+    Run(InParallel(pipelines[I].tally..., pipelines[I].source..., pipelines[I].detector...));
+}
+
+template <size_t P>
+static double blocksPerSecond() {
+    const auto start = std::chrono::steady_clock::now();
+    runPipelines(std::make_index_sequence<P>());
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return (double)(P * BLOCKS_PER_PIPELINE) / elapsed.count();
+}
+
+template <size_t P>
+static void measure(double& single) {
+    const double rate = blocksPerSecond<P>();
+    if (P == 1) single = rate;
+    printf("[Bench] %2u pipelines: %9.0f blocks/s (%7.1f Msamples/s), speed-up %.2f, shakes %ld\n",
+           (unsigned)P, rate, rate * BLOCK_SAMPLES / 1e6, rate / single, pipelines[0].tally.shakes);
+}
+
+int main() {
+    recordTrace();
+    for (int i = 0; i < MAX_PIPELINES; ++i) pipelines[i].detector.setThreshold(2000.0f + 250.0f * i);
+
+    printf("--- Independent shake pipelines on %u hardware threads ---\n",
+           std::thread::hardware_concurrency());
+
+    double single = 0.0;
+    measure<1>(single);
+    measure<2>(single);
+    measure<4>(single);
+    measure<8>(single);
+    measure<16>(single);
+    return 0;
+}
@@ -1,5 +1,7 @@
 #include "csp/csp4cmsis.h"
+#include "csp/coro.h"   // Stackless variant, built when compiling with -std=gnu++20
 #include "cmsis_os2.h"  // CMSIS-RTOS2 header for Nucleo/Keil
+#include "stm32f4xx.h"  // NVIC and DWT, for the interrupt latency benchmark
 #include <cstdio>
 #include <vector>
 
@@ -7,8 +9,19 @@ using namespace csp;
 
 // --- Configuration ---
 #define NUM_RELAYS 5
-#define TEST_ITERATIONS 1000
-#define CHECK_INTERVAL 100
+#define TEST_ITERATIONS 10000
+
+// Hand-offs per run: sender -> relays -> receiver.
+#define TOTAL_HOPS ((uint32_t)TEST_ITERATIONS * (NUM_RELAYS + 1))
+
+static uint32_t bench_start_tick;
+
+static void report(const char* mode, uint32_t elapsed_ms) {
+    if (elapsed_ms == 0) elapsed_ms = 1;
+    printf("[Bench] %s: %lu hand-offs in %lu ms (%lu hand-offs/s)\r\n",
+           mode, (unsigned long)TOTAL_HOPS, (unsigned long)elapsed_ms,
+           (unsigned long)((uint64_t)TOTAL_HOPS * 1000u / elapsed_ms));
+}
 
 // --- 1. Define the Sequential Processes ---
 
@@ -20,6 +33,7 @@ public:
 
     void run() override {
         printf("[Sender] Starting stream...\r\n");
+        bench_start_tick = osKernelGetTickCount();
         for (int i = 1; i <= TEST_ITERATIONS; ++i) {
             out << i;
         }
@@ -64,11 +78,9 @@ public:
                 success = false;
                 break;
             }
-            if (i % CHECK_INTERVAL == 0) {
-                printf("[Receiver] Verified up to %d...\r\n", i);
-            }
         }
         if (success) {
+            report("tasks", osKernelGetTickCount() - bench_start_tick);
             printf("[Receiver] SUCCESS: All %d values verified through %d relays.\r\n", 
                    TEST_ITERATIONS, NUM_RELAYS);
         }
@@ -76,11 +88,489 @@ public:
     }
 };
 
+#if CSP_HAS_COROUTINES
+// --- 1b. The same chain as coroutines, all on one task ---
+
+static coro::Process coSender(coro::Channel<int>& out) {
+    for (int i = 1; i <= TEST_ITERATIONS; ++i) {
+        co_await out.write(i);
+    }
+}
+
+static coro::Process coRelay(coro::Channel<int>& in, coro::Channel<int>& out) {
+    int data;
+    for (int i = 1; i <= TEST_ITERATIONS; ++i) {
+        co_await in.read(data);
+        co_await out.write(data);
+    }
+}
+
+static coro::Process coReceiver(coro::Channel<int>& in, bool& success) {
+    int received;
+    for (int i = 1; i <= TEST_ITERATIONS; ++i) {
+        co_await in.read(received);
+        if (received != i) {
+            printf("[CoReceiver] !! DATA ERROR: Expected %d, Got %d\r\n", i, received);
+            success = false;
+            co_return;
+        }
+    }
+    success = true;
+}
+
+static void runCoroutineChain() {
+    static coro::Channel<int> channels[NUM_RELAYS + 1];
+    static coro::Group<NUM_RELAYS + 2> group;
+    bool success = false;
+
+    group.spawn(coSender(channels[0]));
+    for (int r = 0; r < NUM_RELAYS; ++r) {
+        group.spawn(coRelay(channels[r], channels[r + 1]));
+    }
+    group.spawn(coReceiver(channels[NUM_RELAYS], success));
+
+    uint32_t start = osKernelGetTickCount();
+    Run(InParallel(group));
+    if (success) {
+        report("coroutines", osKernelGetTickCount() - start);
+    }
+}
+#endif
+
+// --- 1c. Statically typed vs type-erased channel ends ---
+// Same-task writes and reads on a buffered channel never block, so the cycles
+// left are the hand-off path itself: direct calls for the typed ends, virtual
+// dispatch for Chanin<int>/Chanout<int>. A hand-off is one write plus one read.
+//
+// Code size: each variant is its own out-of-line handOffBatch instance, listed
+// with its size by
+//     arm-none-eabi-nm -C -S --size-sort Debug/SPI3-NUCLEO-F401RE.elf | grep handOffBatch
+// or found under .text in Debug/SPI3-NUCLEO-F401RE.map. The typed instance has
+// the channel path inlined; the erased one calls the virtual input()/output().
+
+#define DISPATCH_BATCH 16
+#define DISPATCH_ROUNDS 2000
+
+template <typename Writer, typename Reader>
+__attribute__((noinline)) static void handOffBatch(Writer out, Reader in) {
+    int value = 0;
+    for (int i = 0; i < DISPATCH_BATCH; ++i) out << i;
+    for (int i = 0; i < DISPATCH_BATCH; ++i) in >> value;
+}
+
+struct HandOffCycles {
+    uint32_t min_batch;   // fastest batch, the least disturbed by the tick interrupt
+    uint64_t total;
+};
+
+template <typename Writer, typename Reader>
+static HandOffCycles cycleBufferedHandOffs(Writer out, Reader in) {
+    HandOffCycles c = { UINT32_MAX, 0 };
+    for (int r = 0; r < DISPATCH_ROUNDS; ++r) {
+        uint32_t start = DWT->CYCCNT;
+        handOffBatch(out, in);
+        uint32_t cycles = DWT->CYCCNT - start;
+        if (cycles < c.min_batch) c.min_batch = cycles;
+        c.total += cycles;
+    }
+    return c;
+}
+
+static void benchmarkChannelEnds() {
+    static BufferedOne2OneChannel<int, DISPATCH_BATCH> chan;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    HandOffCycles typed = cycleBufferedHandOffs(chan.writer(), chan.reader());
+    HandOffCycles erased = cycleBufferedHandOffs(Chanout<int>(chan.writer()), Chanin<int>(chan.reader()));
+
+    const uint32_t hand_offs = (uint32_t)DISPATCH_ROUNDS * DISPATCH_BATCH;
+    printf("[Bench] %lu buffered hand-offs, cycles per hand-off (best batch / mean): "
+           "typed ends %lu / %lu, type-erased ends %lu / %lu\r\n",
+           (unsigned long)hand_offs,
+           (unsigned long)(typed.min_batch / DISPATCH_BATCH), (unsigned long)(typed.total / hand_offs),
+           (unsigned long)(erased.min_batch / DISPATCH_BATCH), (unsigned long)(erased.total / hand_offs));
+}
+
+// --- 1d. Timed ALT ---
+// Accuracy: a select that can only time out, against the tick count.
+// Cost: selects on an always-ready channel with and without a timeout guard;
+// the difference is what a timeout adds to every timed ALT.
+
+#define TIMEOUT_MS 10
+#define TIMEOUT_ROUNDS 20
+#define TIMED_ALT_ROUNDS 5000
+
+static void benchmarkTimedAlt() {
+    static Channel<int> idle;                        // never written
+    static BufferedOne2OneChannel<int, 1> ready;
+    auto idle_in = idle.reader();
+    auto out = ready.writer();
+    auto in = ready.reader();
+    int value = 0;
+
+    uint32_t min_ticks = UINT32_MAX, max_ticks = 0;
+    for (int r = 0; r < TIMEOUT_ROUNDS; ++r) {
+        RelTimeoutGuard timeout(Milliseconds(TIMEOUT_MS));
+        Alternative alt(idle_in | value, timeout);
+        uint32_t start = osKernelGetTickCount();
+        alt.priSelect();
+        uint32_t took = osKernelGetTickCount() - start;
+        if (took < min_ticks) min_ticks = took;
+        if (took > max_ticks) max_ticks = took;
+    }
+    printf("[Bench] %d ms timeout (%lu ticks): fired after %lu..%lu ticks\r\n",
+           TIMEOUT_MS, (unsigned long)Milliseconds(TIMEOUT_MS).to_ticks(),
+           (unsigned long)min_ticks, (unsigned long)max_ticks);
+
+    RelTimeoutGuard timeout(Milliseconds(TIMEOUT_MS));
+    Alternative plain(in | value);
+    Alternative timed(in | value, timeout);
+
+    uint32_t start = osKernelGetTickCount();
+    for (int r = 0; r < TIMED_ALT_ROUNDS; ++r) { out << r; plain.priSelect(); }
+    uint32_t plain_ms = osKernelGetTickCount() - start;
+
+    start = osKernelGetTickCount();
+    for (int r = 0; r < TIMED_ALT_ROUNDS; ++r) { out << r; timed.priSelect(); }
+    uint32_t timed_ms = osKernelGetTickCount() - start;
+
+    printf("[Bench] %d ALTs on a ready channel: %lu ms untimed, %lu ms with a timeout guard\r\n",
+           TIMED_ALT_ROUNDS, (unsigned long)plain_ms, (unsigned long)timed_ms);
+}
+
+// --- 1e. Wide ALT ---
+// One value waits on the last of N buffered channels before each select, so a
+// priority select has to pass every other guard. Alternative (at most 16 guards)
+// enables and disables them all each time; PersistentAlternative asks only the
+// channel that signalled.
+
+#define WIDE_CHANNELS 64
+#define WIDE_ALT_ROUNDS 2000
+
+static void benchmarkWideAlt() {
+    static BufferedOne2OneChannel<int, 1> chans[WIDE_CHANNELS];
+    static int values[WIDE_CHANNELS];
+    auto out = chans[15].writer();
+    auto wide_out = chans[WIDE_CHANNELS - 1].writer();
+
+    Alternative classic;
+    PersistentAlternative<16> persistent;
+    PersistentAlternative<WIDE_CHANNELS> wide;
+    for (int i = 0; i < WIDE_CHANNELS; ++i) {
+        auto in = chans[i].reader();
+        if (i < 16) {
+            classic.addBinding(in | values[i]);
+            persistent.addBinding(in | values[i]);
+        }
+        wide.addBinding(in | values[i]);
+    }
+
+    uint32_t start = osKernelGetTickCount();
+    for (int r = 0; r < WIDE_ALT_ROUNDS; ++r) { out << r; classic.priSelect(); }
+    uint32_t classic_ms = osKernelGetTickCount() - start;
+
+    start = osKernelGetTickCount();
+    for (int r = 0; r < WIDE_ALT_ROUNDS; ++r) { out << r; persistent.priSelect(); }
+    uint32_t persistent_ms = osKernelGetTickCount() - start;
+
+    start = osKernelGetTickCount();
+    for (int r = 0; r < WIDE_ALT_ROUNDS; ++r) { wide_out << r; wide.priSelect(); }
+    uint32_t wide_ms = osKernelGetTickCount() - start;
+
+    printf("[Bench] %d ALTs over 16 channels: %lu ms Alternative, %lu ms PersistentAlternative; "
+           "over %d channels: %lu ms\r\n",
+           WIDE_ALT_ROUNDS, (unsigned long)classic_ms, (unsigned long)persistent_ms,
+           WIDE_CHANNELS, (unsigned long)wide_ms);
+}
+
+// --- 1f. Interrupt to ALT ---
+// A lower-priority task pends EXTI0 (unused by this example) in software; the
+// handler stamps the cycle counter and fires an IrqGuard that MainApp is
+// selecting on. Measured: handler entry to select() returning.
+
+#define IRQ_LATENCY_ROUNDS 1000
+
+static IrqGuard bench_irq;
+static volatile uint32_t bench_irq_cycles;
+
+extern "C" void EXTI0_IRQHandler(void) {
+    bench_irq_cycles = DWT->CYCCNT;
+    bench_irq.fireFromISR();
+}
+
+static void pendBenchIrq(void*) {
+    for (int r = 0; r < IRQ_LATENCY_ROUNDS; ++r) {
+        osDelay(1);
+        NVIC_SetPendingIRQ(EXTI0_IRQn);
+    }
+    osThreadExit();
+}
+
+static void benchmarkIrqLatency() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    NVIC_SetPriority(EXTI0_IRQn, configMAX_SYSCALL_INTERRUPT_PRIORITY >> (8 - __NVIC_PRIO_BITS));
+    NVIC_EnableIRQ(EXTI0_IRQn);
+
+    const osThreadAttr_t attr = { .name = "IrqPend", .stack_size = 512, .priority = osPriorityNormal };
+    osThreadNew(pendBenchIrq, NULL, &attr);
+
+    Alternative alt(bench_irq);
+    uint32_t min_cycles = UINT32_MAX, max_cycles = 0;
+    uint64_t sum_cycles = 0;
+    uint32_t rounds = 0, selects = 0;
+    while (rounds < IRQ_LATENCY_ROUNDS) {
+        alt.priSelect();
+        uint32_t cycles = DWT->CYCCNT - bench_irq_cycles;
+        if (cycles < min_cycles) min_cycles = cycles;
+        if (cycles > max_cycles) max_cycles = cycles;
+        sum_cycles += cycles;
+        selects++;
+        rounds += bench_irq.firings();
+    }
+    NVIC_DisableIRQ(EXTI0_IRQn);
+
+    printf("[Bench] interrupt to ALT: min %lu, mean %lu, max %lu cycles\r\n",
+           (unsigned long)min_cycles, (unsigned long)(sum_cycles / selects),
+           (unsigned long)max_cycles);
+}
+
+// --- 1g. Barrier ---
+// Sync rounds per second with 2..16 processes: MainApp and N-1 helper tasks,
+// which enrol for a run and resign after it.
+
+#define BARRIER_ROUNDS 2000
+#define BARRIER_MAX_PROCS 16
+
+static Barrier bench_barrier(1);                        // MainApp
+static Channel<int> barrier_go[BARRIER_MAX_PROCS - 1];
+static Any2OneChannel<int, BARRIER_MAX_PROCS> barrier_done;
+
+static void barrierHelper(void* arg) {
+    auto go = barrier_go[(uintptr_t)arg].reader();
+    auto done = barrier_done.writer();
+    int rounds;
+    while (true) {
+        go >> rounds;
+        for (int r = 0; r < rounds; ++r) bench_barrier.sync();
+        bench_barrier.resign();
+        done << 1;
+    }
+}
+
+static void benchmarkBarrier() {
+    for (uintptr_t i = 0; i < BARRIER_MAX_PROCS - 1; ++i) {
+        const osThreadAttr_t attr = { .name = "Sync", .stack_size = 512, .priority = osPriorityAboveNormal };
+        osThreadNew(barrierHelper, (void*)i, &attr);
+    }
+
+    for (int procs = 2; procs <= BARRIER_MAX_PROCS; procs *= 2) {
+        for (int i = 0; i < procs - 1; ++i) bench_barrier.enroll();
+        for (int i = 0; i < procs - 1; ++i) barrier_go[i].writer() << BARRIER_ROUNDS;
+
+        uint32_t start = osKernelGetTickCount();
+        for (int r = 0; r < BARRIER_ROUNDS; ++r) bench_barrier.sync();
+        uint32_t elapsed_ms = osKernelGetTickCount() - start;
+        if (elapsed_ms == 0) elapsed_ms = 1;
+
+        int ack;
+        for (int i = 0; i < procs - 1; ++i) barrier_done.reader() >> ack;
+
+        printf("[Bench] barrier, %d processes: %lu syncs/s\r\n",
+               procs, (unsigned long)((uint64_t)BARRIER_ROUNDS * 1000u / elapsed_ms));
+    }
+}
+
+// --- 1h. Request/reply ---
+// A 32-byte status reply fetched from a server task: over a CallChannel (one
+// hand-off, reply written in place) and over a request and a reply channel.
+
+#define CALL_ROUNDS 5000
+
+struct StatusReply {
+    uint32_t words[8];
+};
+
+static CallChannel<int, StatusReply> status_calls;
+static Channel<int> status_requests;
+static Channel<StatusReply> status_replies;
+
+static void statusServer(void*) {
+    auto calls = status_calls.server();
+    auto requests = status_requests.reader();
+    auto replies = status_replies.writer();
+    StatusReply status = {};
+    int request;
+
+    Alternative alt(calls.acceptGuard(), requests | request);
+    while (true) {
+        if (alt.priSelect() == 0) {
+            calls.accept([&](const int& q, StatusReply& reply) {
+                status.words[0] = (uint32_t)q;
+                reply = status;
+            });
+        } else {
+            status.words[0] = (uint32_t)request;
+            replies << status;
+        }
+    }
+}
+
+static void benchmarkCalls() {
+    const osThreadAttr_t attr = { .name = "Status", .stack_size = 512, .priority = osPriorityAboveNormal };
+    osThreadNew(statusServer, NULL, &attr);
+
+    auto client = status_calls.client();
+    auto requests = status_requests.writer();
+    auto replies = status_replies.reader();
+    StatusReply reply;
+
+    uint32_t start = osKernelGetTickCount();
+    for (int r = 0; r < CALL_ROUNDS; ++r) client.call(r, reply);
+    uint32_t call_ms = osKernelGetTickCount() - start;
+
+    start = osKernelGetTickCount();
+    for (int r = 0; r < CALL_ROUNDS; ++r) { requests << r; replies >> reply; }
+    uint32_t pair_ms = osKernelGetTickCount() - start;
+
+    printf("[Bench] %d status requests: %lu ms CallChannel, %lu ms request + reply channels\r\n",
+           CALL_ROUNDS, (unsigned long)call_ms, (unsigned long)pair_ms);
+}
+
+// --- 1i. Priority inheritance ---
+// MainApp reads from a low-priority producer while a medium-priority task burns
+// the CPU in bursts. Without inheritance a read waits out the bursts; with it,
+// the blocked read lends the producer its priority. Reported: the worst read.
+
+#define INHERIT_ROUNDS 200
+#define BUSY_BURST_MS 5
+
+static One2OneChannel<int> plain_feed;
+static One2OneChannel<int> inheriting_feed(InheritPriority);
+static volatile bool busy_running;
+
+static void feedProducer(void* arg) {
+    auto out = static_cast<One2OneChannel<int>*>(arg)->writer();
+    for (int r = 0; r < INHERIT_ROUNDS; ++r) {
+        for (volatile int spin = 0; spin < 2000; ++spin) {}   // some work per value
+        out << r;
+    }
+    osThreadExit();
+}
+
+static void busyTask(void*) {
+    while (busy_running) {
+        uint32_t until = osKernelGetTickCount() + BUSY_BURST_MS;
+        while (osKernelGetTickCount() < until) {}
+        osDelay(1);
+    }
+    osThreadExit();
+}
+
+static uint32_t worstRead(One2OneChannel<int>& feed) {
+    const osThreadAttr_t producer = { .name = "Feed", .stack_size = 512, .priority = osPriorityLow };
+    const osThreadAttr_t busy = { .name = "Busy", .stack_size = 256, .priority = osPriorityNormal };
+    busy_running = true;
+    osThreadNew(busyTask, NULL, &busy);
+    osThreadNew(feedProducer, &feed, &producer);
+
+    auto in = feed.reader();
+    uint32_t worst = 0;
+    int value;
+    for (int r = 0; r < INHERIT_ROUNDS; ++r) {
+        uint32_t start = osKernelGetTickCount();
+        in >> value;
+        uint32_t took = osKernelGetTickCount() - start;
+        if (took > worst) worst = took;
+    }
+    busy_running = false;
+    return worst;
+}
+
+static void benchmarkPriorityInheritance() {
+    uint32_t plain_ms = worstRead(plain_feed);
+    osDelay(BUSY_BURST_MS * 2);
+    uint32_t inherit_ms = worstRead(inheriting_feed);
+    osDelay(BUSY_BURST_MS * 2);
+
+    printf("[Bench] worst read from a low-priority writer under load: %lu ms plain, "
+           "%lu ms with priority inheritance (max boost %lu)\r\n",
+           (unsigned long)plain_ms, (unsigned long)inherit_ms,
+           (unsigned long)inheriting_feed.maxPriorityBoost());
+}
+
+// --- 1j. Fork/join ---
+// Short parallel sections: four detector variants over one captured block,
+// forked with Run(InParallel(...)) and joined again. The pooled detectors fit a
+// pool worker's stack; the same work with a larger declared stack gets a task
+// created and deleted per fork. Reported: microseconds per fork/join.
+
+#define FORK_ROUNDS 1000
+#define FORK_BLOCK 64
+
+static int16_t captured_block[FORK_BLOCK];
+
+template <size_t StackWords>
+class Detector : public CSProcessWithStack<StackWords> {
+private:
+    int16_t threshold;
+public:
+    uint32_t hits = 0;
+    explicit Detector(int16_t t) : threshold(t) {}
+    void run() override {
+        for (int i = 0; i < FORK_BLOCK; ++i) {
+            if (captured_block[i] > threshold) hits++;
+        }
+    }
+};
+
+using PooledDetector = Detector<CSP_TASK_POOL_STACK_WORDS>;
+using OwnTaskDetector = Detector<CSP_TASK_POOL_STACK_WORDS + 64>;
+
+template <typename D>
+static uint32_t forkJoinMicros(D& a, D& b, D& c, D& d) {
+    uint32_t start = osKernelGetTickCount();
+    for (int r = 0; r < FORK_ROUNDS; ++r) Run(InParallel(a, b, c, d));
+    uint32_t elapsed_ms = osKernelGetTickCount() - start;
+    return (uint32_t)((uint64_t)elapsed_ms * 1000u / FORK_ROUNDS);
+}
+
+static void benchmarkForkJoin() {
+    for (int i = 0; i < FORK_BLOCK; ++i) captured_block[i] = (int16_t)((i * 37) % 200 - 100);
+
+    static PooledDetector p0(-50), p1(0), p2(25), p3(50);
+    static OwnTaskDetector t0(-50), t1(0), t2(25), t3(50);
+
+    uint32_t pooled_us = forkJoinMicros(p0, p1, p2, p3);
+    uint32_t own_us = forkJoinMicros(t0, t1, t2, t3);
+
+    printf("[Bench] fork/join of 4 detectors: %lu us on pool workers (%u created), "
+           "%lu us creating a task per process\r\n",
+           (unsigned long)pooled_us, (unsigned)internal::TaskPool::workersCreated(),
+           (unsigned long)own_us);
+}
+
 // --- 2. Network Construction ---
 
 void MainApp_Task(void* params) {
     // 500ms delay to allow UART/Serial to stabilize
     osDelay(500); 
+
+    benchmarkChannelEnds();
+    benchmarkTimedAlt();
+    benchmarkWideAlt();
+    benchmarkIrqLatency();
+    benchmarkBarrier();
+    benchmarkCalls();
+    benchmarkPriorityInheritance();
+    benchmarkForkJoin();
+
+#if CSP_HAS_COROUTINES
+    printf("\r\n--- Relay Chain on one task (C++20 coroutines) ---\r\n");
+    runCoroutineChain();
+#endif
     printf("\r\n--- Launching CSP Relay Chain (Nucleo/CMSIS-RTOS2) ---\r\n");
 
     static Channel<int> channels[NUM_RELAYS + 1];
@@ -3,16 +3,16 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
-#include "timers.h"
-#include "event_groups.h"
+#include "event_groups.h"   // EventBits_t
 #include <stddef.h> 
+#include <stdint.h>
+#include <atomic>
+#include <cstdio>
 #include <initializer_list>
 #include "time.h" 
+#include "channel_base.h" // Chanin/Chanout forward declarations
 
 namespace csp {
-    // Forward declarations
-    template <typename T> class Chanin;
-    template <typename T> class Chanout;
 
     namespace internal {
         class AltScheduler; 
@@ -26,37 +26,117 @@ namespace csp {
             virtual bool disable() = 0;
             virtual void activate() = 0;
             virtual ~Guard() = default;
+
+            /**
+             * @brief Timeout guards: the tick at which the guard becomes ready.
+             * select() blocks no longer than the earliest deadline of its guards.
+             */
+            virtual bool deadline(TickType_t* at) const { (void)at; return false; }
         };
 
+        /**
+         * @brief Waits for the guards of one ALT. Guards record their fired bit in
+         * `fired`; the selecting task, bound at each select(), sleeps on its task
+         * notification and is given exactly one notification per wait, which the
+         * select itself consumes, so none is left over for a later channel
+         * operation of the same task. Waking it from an ISR is a single
+         * vTaskNotifyGiveFromISR(); nothing is allocated and no timer task is involved.
+         */
         class AltScheduler {
         private:
+            enum : uint32_t { IDLE, WAITING, NOTIFIED };
+
             TaskHandle_t waiting_task_handle = nullptr;
-            EventGroupHandle_t event_group = nullptr;
+            std::atomic<uint32_t> fired{0};
+            std::atomic<uint32_t> wait_state{IDLE};
+            TickType_t select_start = 0;
+            std::atomic<uint32_t>* ready_words = nullptr;   // persistent mode: one bit per guard
+
+            void bindToCurrentTask();
+            void wait(uint32_t mask, TickType_t block);
         public:
-            AltScheduler();
-            ~AltScheduler(); 
-            void initForCurrentTask(); 
+            AltScheduler() = default;
+            AltScheduler(const AltScheduler&) = delete;
+            AltScheduler& operator=(const AltScheduler&) = delete;
+
             unsigned int select(Guard** guardArray, size_t amount, size_t offset = 0);
             void wakeUp(EventBits_t bit); 
-            EventGroupHandle_t getEventGroupHandle() const { return event_group; }
+
+            /**
+             * @brief Persistent mode (PersistentAlternative): guards are enabled with
+             * their index instead of an event bit, stay registered between selects,
+             * and wakeUp(index) sets that guard's bit in words.
+             */
+            void usePersistentMask(std::atomic<uint32_t>* words) { ready_words = words; }
+            unsigned int selectPersistent(Guard** guardArray, size_t amount,
+                                          const uint32_t* timeout_mask, size_t offset = 0);
+
+            // Tick count when the current select() began; relative timeouts count from it
+            TickType_t selectStart() const { return select_start; }
         };
 
-        class TimerGuard : public Guard {
+        /**
+         * @brief Ready once a deadline has passed. No timer is involved: select()
+         * uses the deadline as the block time of its own wait.
+         */
+        class TimeoutGuard : public Guard {
         private:
-            AltScheduler* parent_alt;
-            TickType_t delay_ticks;
-            TimerHandle_t timer_handle;
-            EventBits_t assigned_bit; 
-            static void TimerCallback(TimerHandle_t xTimer);
+            TickType_t ticks;       // delay from the start of select(), or the absolute tick
+            bool absolute;
+            TickType_t at = 0;
+            bool expired() const;
         public:
-            TimerGuard(csp::Time delay);
-            ~TimerGuard() override;
+            constexpr TimeoutGuard(TickType_t t, bool is_absolute) : ticks(t), absolute(is_absolute) {}
+            void setTicks(TickType_t t) { ticks = t; }
             bool enable(AltScheduler* alt, EventBits_t bit) override;
             bool disable() override; 
             void activate() override; 
+            bool deadline(TickType_t* out) const override;
+        };
+
+        /**
+         * @brief Guard on an interrupt line: fire() from the ISR sets the guard's
+         * ALT bit directly. Firings before the guard is selected are coalesced
+         * into one selection and counted.
+         */
+        class IrqLineGuard : public Guard {
+        private:
+            AltScheduler* volatile parent_alt = nullptr;
+            volatile EventBits_t assigned_bit = 0;
+            volatile uint32_t pending = 0;        // firings not yet taken by a selection
+            volatile uint32_t coalesced = 0;      // firings merged into an earlier one
+            uint32_t taken = 0;                   // firings covered by the last selection
+        public:
+            constexpr IrqLineGuard() = default;
+            void fire();
+            uint32_t coalescedCount() const { return coalesced; }
+            uint32_t takenCount() const { return taken; }
+            bool enable(AltScheduler* alt, EventBits_t bit) override;
+            bool disable() override;
+            void activate() override;
         };
     } // namespace internal
 
+    /**
+     * @brief Destination of a batch read used as an ALT guard:
+     *     size_t n;
+     *     Alternative alt(in | batch(window, n, 4), timeout);
+     * The guard is ready once min_count elements are buffered; when selected it
+     * takes up to max_count of them and stores how many in count.
+     */
+    template <typename T>
+    struct Batch {
+        T* items;
+        size_t max_count;
+        size_t min_count;
+        size_t& count;
+    };
+
+    template <typename T, size_t N>
+    Batch<T> batch(T (&items)[N], size_t& count, size_t min_count = N) {
+        return Batch<T>{ items, N, min_count, count };
+    }
+
     /**
      * @brief Glue logic for Pipe Syntax (chan | msg).
      * MOVED HERE: Now fully defined before being used in public_channel.h or Alternative.
@@ -85,15 +165,78 @@ namespace csp {
         Guard(internal::Guard* internal_ptr) : internal_guard_ptr(internal_ptr) {}
     };
 
+    namespace internal {
+        // The scheduler-side guard behind anything an Alternative accepts
+        template <typename T, typename End>
+        Guard* guardOf(const ChannelBinding<T, End>& b) { return b.getInternalGuard(); }
+        inline Guard* guardOf(csp::Guard& g) { return g.internal_guard_ptr; }
+        inline Guard* guardOf(Guard* g) { return g; }
+    } // namespace internal
+
+    /**
+     * @brief Ready once delay has passed since the select() began.
+     */
     class RelTimeoutGuard : public Guard {
     private:
-        internal::TimerGuard timer_storage;
+        internal::TimeoutGuard timer_storage;
     public:
         RelTimeoutGuard(csp::Time delay) 
-            : Guard(&timer_storage), timer_storage(delay) {}
+            : Guard(&timer_storage), timer_storage(delay.to_ticks(), false) {}
         ~RelTimeoutGuard() override = default;
     };
 
+    /**
+     * @brief Ready once the tick count reaches an absolute deadline; for periodic
+     * loops that must not drift:
+     *
+     *     Time next = Now() + period;
+     *     AbsTimeoutGuard tick(next);
+     *     Alternative alt(in | msg, tick);
+     *     while (true) {
+     *         if (alt.priSelect() == 1) tick.set(next = next + period);
+     *         ...
+     *     }
+     */
+    class AbsTimeoutGuard : public Guard {
+    private:
+        internal::TimeoutGuard timer_storage;
+    public:
+        AbsTimeoutGuard(csp::Time deadline)
+            : Guard(&timer_storage), timer_storage(deadline.to_ticks(), true) {}
+        ~AbsTimeoutGuard() override = default;
+
+        void set(csp::Time deadline) { timer_storage.setTicks(deadline.to_ticks()); }
+    };
+
+    /**
+     * @brief An interrupt as an ALT guard, with no channel in between:
+     *
+     *     static IrqGuard button;                     // shared with the ISR
+     *     button.fireFromISR();                       // in the ISR
+     *
+     *     RelTimeoutGuard timeout(Milliseconds(50));
+     *     Alternative alt(drdy, button, timeout);     // drdy: another IrqGuard
+     *     switch (alt.priSelect()) { ... }
+     *
+     * Firings while the guard is not being selected are kept: the next ALT finds it
+     * ready at once. Several firings before a selection count as one;
+     * firings() gives how many the last selection covered and coalesced() the
+     * running total of merged ones.
+     */
+    class IrqGuard : public Guard {
+    private:
+        internal::IrqLineGuard line;
+    public:
+        IrqGuard() : Guard(&line) {}
+        IrqGuard(const IrqGuard&) = delete;
+        IrqGuard& operator=(const IrqGuard&) = delete;
+        ~IrqGuard() override = default;
+
+        void fireFromISR() { line.fire(); }
+        uint32_t firings() const { return line.takenCount(); }
+        uint32_t coalesced() const { return line.coalescedCount(); }
+    };
+
     class Alternative {
     private:
         static const size_t MAX_GUARDS = 16;
@@ -110,7 +253,7 @@ namespace csp {
          * @brief Variadic constructor to allow Alternative alt(in1 | msg1, timer);
          */
         template <typename... Bindings>
-        Alternative(Bindings... bindings) : num_guards(0) {
+        Alternative(Bindings&&... bindings) : num_guards(0) {
             (addBinding(bindings), ...);
         }
 
@@ -122,16 +265,32 @@ namespace csp {
 
     
         // Binding helper for Input Channels
-        template <typename T>
-        void addBinding(const ChannelBinding<T, Chanin<T>>& b) {
+        template <typename T, typename C>
+        void addBinding(const ChannelBinding<T, Chanin<T, C>>& b) {
             if (num_guards < MAX_GUARDS) {
                 internal_guards[num_guards++] = b.getInternalGuard(); 
             }
         }
 
         // Binding helper for Output Channels
-        template <typename T>
-        void addBinding(const ChannelBinding<const T, Chanout<T>>& b) {
+        template <typename T, typename C>
+        void addBinding(const ChannelBinding<const T, Chanout<T, C>>& b) {
+            if (num_guards < MAX_GUARDS) {
+                internal_guards[num_guards++] = b.getInternalGuard();
+            }
+        }
+
+        // Binding helper for batch reads on buffered channels
+        template <typename T, typename C>
+        void addBinding(const ChannelBinding<const Batch<T>, Chanin<T, C>>& b) {
+            if (num_guards < MAX_GUARDS) {
+                internal_guards[num_guards++] = b.getInternalGuard();
+            }
+        }
+
+        // Binding helper for any other channel end that provides getGuard(data)
+        template <typename T, typename End>
+        void addBinding(const ChannelBinding<T, End>& b) {
             if (num_guards < MAX_GUARDS) {
                 internal_guards[num_guards++] = b.getInternalGuard();
             }
@@ -144,6 +303,26 @@ namespace csp {
                 internal_guards[num_guards++] = tg.internal_guard_ptr;
             }
         }
+
+        void addBinding(AbsTimeoutGuard& tg) {
+            if (num_guards < MAX_GUARDS) {
+                internal_guards[num_guards++] = tg.internal_guard_ptr;
+            }
+        }
+
+        // Binding helper for interrupt lines
+        void addBinding(IrqGuard& ig) {
+            if (num_guards < MAX_GUARDS) {
+                internal_guards[num_guards++] = ig.internal_guard_ptr;
+            }
+        }
+
+        // Binding helper for any other public guard (BarrierGuard, BucketGuard)
+        void addBinding(csp::Guard& g) {
+            if (num_guards < MAX_GUARDS) {
+                internal_guards[num_guards++] = g.internal_guard_ptr;
+            }
+        }
         
         // Handle direct internal guards if passed
         void addBinding(internal::Guard* g) {
@@ -152,6 +331,87 @@ namespace csp {
             }
         }
     };
+
+    /**
+     * @brief ALT whose guards stay registered with their channels between selects.
+     *
+     *     PersistentAlternative<64> alt(in[0] | v[0], in[1] | v[1], ..., timeout);
+     *     while (true) {
+     *         int i = alt.fairSelect();
+     *         ...
+     *     }
+     *
+     * Alternative enables and disables every guard on every select, which for
+     * rendezvous channels means two mutex operations per guard. Here each guard is
+     * enabled once and then left registered; a channel that becomes ready sets the
+     * guard's bit in a readiness mask, and select() picks the first set bit (by
+     * index, or rotating from the last selection for fairSelect) with a
+     * count-leading/trailing-zeros scan. Only guards whose bit is set are asked
+     * again, so a select costs channel locks for the guards that signalled, not
+     * for all MaxGuards of them. Guards are disabled when the object is destroyed.
+     *
+     * While registered, a channel treats the process as waiting in an ALT even
+     * when it is busy elsewhere: a writer to one of its rendezvous channels blocks
+     * until the next select takes the value, and a timed write does not give up
+     * before then.
+     */
+    template <size_t MaxGuards = 64>
+    class PersistentAlternative {
+    private:
+        static constexpr size_t WORDS = (MaxGuards + 31) / 32;
+
+        internal::Guard* guards[MaxGuards];
+        size_t num_guards = 0;
+        std::atomic<uint32_t> ready[WORDS];
+        uint32_t timeouts[WORDS];                 // guards re-armed on every select
+        internal::AltScheduler internal_alt;
+        size_t fair_select_start_index = 0;
+        bool started = false;
+
+        void add(internal::Guard* g) {
+            if (num_guards == MaxGuards) {
+                printf("CSP ERROR: PersistentAlternative has more guards than MaxGuards.\r\n");
+                configASSERT(pdFALSE);
+                return;
+            }
+            TickType_t at;
+            uint32_t bit = 1u << (num_guards % 32);
+            if (g->deadline(&at)) timeouts[num_guards / 32] |= bit;
+            ready[num_guards / 32].fetch_or(bit);    // asked on the first select
+            guards[num_guards++] = g;
+        }
+
+    public:
+        template <typename... Bindings>
+        PersistentAlternative(Bindings&&... bindings) : ready(), timeouts() {
+            internal_alt.usePersistentMask(ready);
+            (add(internal::guardOf(bindings)), ...);
+        }
+
+        ~PersistentAlternative() {
+            if (!started) return;
+            for (size_t i = 0; i < num_guards; ++i) guards[i]->disable();
+        }
+
+        PersistentAlternative(const PersistentAlternative&) = delete;
+        PersistentAlternative& operator=(const PersistentAlternative&) = delete;
+
+        // For guard sets built in a loop; only before the first select
+        template <typename Binding>
+        void addBinding(Binding&& b) { add(internal::guardOf(b)); }
+
+        int priSelect() {
+            started = true;
+            return (int)internal_alt.selectPersistent(guards, num_guards, timeouts);
+        }
+
+        int fairSelect() {
+            started = true;
+            size_t i = internal_alt.selectPersistent(guards, num_guards, timeouts, fair_select_start_index);
+            if (num_guards > 0) fair_select_start_index = (i + 1) % num_guards;
+            return (int)i;
+        }
+    };
 } 
 
 #endif // CSP4CMSIS_ALT_H
\ No newline at end of file
@@ -4,8 +4,16 @@
 #include "FreeRTOS.h"
 #include "semphr.h"
 #include "alt.h"      
+#include "static_alloc.h"
+#include "payload.h"
 #include <cstdio> 
 
+// Tasks that can run on an inherited priority at the same time, across all
+// channels with priority inheritance.
+#ifndef CSP_MAX_BOOSTED_TASKS
+#define CSP_MAX_BOOSTED_TASKS 8
+#endif
+
 namespace csp::internal {
 
     class AltScheduler;
@@ -17,18 +25,16 @@ namespace csp::internal {
         AltScheduler* alt_ptr;
         EventBits_t assigned_bit;
         void* data_ptr;
-        size_t data_size;
 
-        WaitingAlt() : alt_ptr(nullptr), assigned_bit(0), data_ptr(nullptr), data_size(0) {}
+        constexpr WaitingAlt() : alt_ptr(nullptr), assigned_bit(0), data_ptr(nullptr) {}
 
         /**
          * @brief Atomically configure the ALT registration.
          */
-        void set(AltScheduler* a, EventBits_t b, void* d, size_t s) {
+        void set(AltScheduler* a, EventBits_t b, void* d) {
             alt_ptr = a;
             assigned_bit = b;
             data_ptr = d;
-            data_size = s;
         }
 
         /**
@@ -38,7 +44,6 @@ namespace csp::internal {
             alt_ptr = nullptr;
             assigned_bit = 0;
             data_ptr = nullptr;
-            data_size = 0;
         }
     };
 
@@ -47,7 +52,10 @@ namespace csp::internal {
      */
     class AltChanSyncBase {
     protected:
-        SemaphoreHandle_t mutex; 
+        StaticMutex mutex; 
+
+        // Typed copy/move for the channel's T
+        const PayloadOps* payload;
         
         // Slots for processes currently blocked in an Alternative (ALT) select
         WaitingAlt waiting_in_alt;
@@ -59,25 +67,82 @@ namespace csp::internal {
         void* non_alt_in_data_ptr;
         const void* non_alt_out_data_ptr;
 
-    public:
-        AltChanSyncBase();
-        virtual ~AltChanSyncBase();
+        // Set when the waiting writer passed an rvalue: its object may be moved from
+        bool out_movable;
+
+        // Set while the waiting reader is in an extended input (no destination buffer)
+        bool ext_in_waiting;
+
+        // The writer whose buffer an extended reader holds. It is off the waiting
+        // slot (a timed write cannot withdraw, another writer may register) and
+        // stays blocked until releaseExtWriter().
+        TaskHandle_t ext_writer;
+        const void* ext_data_ptr;
 
-        // Perform or verify a rendezvous
-        bool tryHandshake(void* data_ptr, size_t size, bool is_writer);
+        // Priority inheritance (opt-in): a task blocked on the channel lends its
+        // priority to the task last seen on the other end, until it is taken off.
+        // The priority to return to is kept per task, not per channel, since a
+        // task can be boosted through several channels at once.
+        bool inherit_priority;
+        TaskHandle_t last_reader;
+        TaskHandle_t last_writer;
+        TaskHandle_t boosted_task;
+        UBaseType_t max_boost;
+
+    public:
+        constexpr explicit AltChanSyncBase(const PayloadOps* ops, bool inherit = false) :
+            mutex(), payload(ops), waiting_in_alt(), waiting_out_alt(),
+            waiting_in_task(nullptr), waiting_out_task(nullptr),
+            non_alt_in_data_ptr(nullptr), non_alt_out_data_ptr(nullptr),
+            out_movable(false), ext_in_waiting(false),
+            ext_writer(nullptr), ext_data_ptr(nullptr),
+            inherit_priority(inherit), last_reader(nullptr), last_writer(nullptr),
+            boosted_task(nullptr), max_boost(0) {}
+        virtual ~AltChanSyncBase() = default;
+
+        // Perform or verify a rendezvous. A writer's data_ptr is moved from if movable.
+        bool tryHandshake(void* data_ptr, bool is_writer, bool movable = false);
         
         // Register a standard task for blocking I/O
-        void registerWaitingTask(void* data_ptr, bool is_writer);
+        void registerWaitingTask(void* data_ptr, bool is_writer, bool movable = false);
+
+        // After a timed wait expired: withdraw, or return true if a partner committed meanwhile
+        bool withdraw(bool is_writer);
+
+        // Typed hand-off of one value (no-op if either side has no buffer)
+        void transfer(void* dest, const void* src, bool movable) const;
+
+        // Extended rendezvous: the reader borrows the writer's buffer
+        void registerExtReader();
+        void lendToExtReader(const void* data_ptr);
+        const void* borrowFromWriter();
+        void releaseExtWriter();
+        bool isExtReaderWaiting() const { return waiting_in_task != nullptr && ext_in_waiting; }
+        const void* getExtDataPtr() const { return ext_data_ptr; }
         
-        void clearWaitingIn() { waiting_in_task = nullptr; non_alt_in_data_ptr = nullptr; }
-        void clearWaitingOut() { waiting_out_task = nullptr; non_alt_out_data_ptr = nullptr; }
+        void clearWaitingIn() { waiting_in_task = nullptr; non_alt_in_data_ptr = nullptr; ext_in_waiting = false; }
+        void clearWaitingOut() { waiting_out_task = nullptr; non_alt_out_data_ptr = nullptr; out_movable = false; }
+
+        // Priority inheritance, all called with the mutex held from a task.
+        // noteEnd() records the caller as the task on its end; boostPartner() is
+        // called once the caller is registered as waiting; endBoost() once the
+        // waiting task has been taken off the channel.
+        void noteEnd(bool is_writer) {
+            if (!inherit_priority) return;
+            if (is_writer) last_writer = xTaskGetCurrentTaskHandle();
+            else last_reader = xTaskGetCurrentTaskHandle();
+        }
+        void boostPartner(bool is_writer);
+        void endBoost();
+        UBaseType_t maxPriorityBoost() const { return max_boost; }
 
         // Getters for thread safety and logic
-        SemaphoreHandle_t getMutex() { return mutex; }
+        SemaphoreHandle_t getMutex() { return mutex.get(); }
         TaskHandle_t getWaitingInTask() const { return waiting_in_task; }
         TaskHandle_t getWaitingOutTask() const { return waiting_out_task; }
         void* getNonAltInDataPtr() const { return non_alt_in_data_ptr; }
         const void* getNonAltOutDataPtr() const { return non_alt_out_data_ptr; }
+        bool isNonAltOutMovable() const { return out_movable; }
         
         AltScheduler* getAltInScheduler() const { return waiting_in_alt.alt_ptr; }
         EventBits_t   getAltInBit() const       { return waiting_in_alt.assigned_bit; }
@@ -92,14 +157,13 @@ namespace csp::internal {
     // Guards: Interfaces between Channels and the AltScheduler
     // =============================================================
 
-    class ChanInGuard : public Guard {
+    class ChanInGuard final : public Guard {
     private: 
         AltChanSyncBase* parent_channel;
         void* user_data_dest; 
-        size_t data_size;
     public:
-        ChanInGuard(AltChanSyncBase* parent, void* dest = nullptr, size_t size = 0) 
-            : parent_channel(parent), user_data_dest(dest), data_size(size) {}
+        constexpr ChanInGuard(AltChanSyncBase* parent, void* dest = nullptr) 
+            : parent_channel(parent), user_data_dest(dest) {}
         
         bool enable(AltScheduler* alt, EventBits_t bit) override;
         bool disable() override;
@@ -107,14 +171,29 @@ namespace csp::internal {
         void updateBuffer(void* new_dest) { user_data_dest = new_dest; }
     };
 
-    class ChanOutGuard : public Guard { 
+    /**
+     * @brief Reader-side guard that is ready while a writer waits, and takes
+     * nothing when selected: the reader then completes with input() or an
+     * extended input, which finds the writer parked.
+     */
+    class ChanInPendingGuard final : public Guard {
+    private:
+        AltChanSyncBase* parent_channel;
+    public:
+        constexpr explicit ChanInPendingGuard(AltChanSyncBase* parent) : parent_channel(parent) {}
+
+        bool enable(AltScheduler* alt, EventBits_t bit) override;
+        bool disable() override;
+        void activate() override {}
+    };
+
+    class ChanOutGuard final : public Guard { 
     private: 
         AltChanSyncBase* parent_channel;
         const void* user_data_source; 
-        size_t data_size;
     public:
-        ChanOutGuard(AltChanSyncBase* parent, const void* src = nullptr, size_t size = 0) 
-            : parent_channel(parent), user_data_source(src), data_size(size) {}
+        constexpr ChanOutGuard(AltChanSyncBase* parent, const void* src = nullptr) 
+            : parent_channel(parent), user_data_source(src) {}
         
         bool enable(AltScheduler* alt, EventBits_t bit) override;
         bool disable() override;
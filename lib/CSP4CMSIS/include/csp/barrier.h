@@ -4,48 +4,202 @@
 
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "event_groups.h"
+#include "static_alloc.h"
+#include "alt.h"
 #include <stddef.h> // For size_t
+#include <stdint.h>
 
 namespace csp {
-   
+
     namespace internal {
 
+        class Barrier;
+        class Bucket;
+
+        // ALT side of a Barrier: ready when every other enrolled process is waiting
+        class BarrierAltGuard final : public Guard {
+        private:
+            Barrier* barrier;
+        public:
+            constexpr BarrierAltGuard(Barrier* b) : barrier(b) {}
+            bool enable(AltScheduler* alt, EventBits_t bit) override;
+            bool disable() override;
+            void activate() override;
+        };
+
+        // ALT side of a Bucket: in the bucket while enabled, ready once it is flushed
+        class BucketAltGuard final : public Guard {
+        private:
+            Bucket* bucket;
+            uint32_t entered_at = 0;   // flush count when the guard was enabled
+            bool inside = false;
+            friend class Bucket;
+        public:
+            constexpr BucketAltGuard(Bucket* b) : bucket(b) {}
+            bool enable(AltScheduler* alt, EventBits_t bit) override;
+            bool disable() override;
+            void activate() override {}
+        };
+
         /**
-         * @brief A reusable synchronization point where a fixed number of processes 
-         * must arrive before any are allowed to proceed.
+         * @brief A reusable synchronization point: each phase completes once every
+         * enrolled process has arrived, and all of them go on together.
+         *
+         * Waiters block on the event bit of their phase's parity, so the last
+         * arrival releases all of them with one xEventGroupSetBits(). It clears the
+         * next phase's bit first, under the same mutex that counts arrivals, so a
+         * process that comes straight back for the next phase waits for it.
+         *
+         * The number of processes can change: enroll() before taking part,
+         * resign() when leaving. One enrolled process at a time may offer to sync
+         * in an ALT (BarrierGuard); the guard is ready once all the others wait.
          */
         class Barrier {
         private:
-            const size_t max_processes;
-            size_t count; // Protected by xCountMutex
-            
-            SemaphoreHandle_t xCountMutex;      // Protects the 'count' variable
-            SemaphoreHandle_t xWaitSemaphore;   // Used to block and release tasks
+            size_t enrolled;
+            size_t arrived;                    // in the current phase
+            uint32_t phases;                   // completed so far
+
+            StaticMutex xCountMutex;           // Protects the counts and the ALT slot
+            StaticEventGroup xReleased;        // Bit (phase & 1) set when that phase completes
+
+            AltScheduler* alt = nullptr;
+            EventBits_t alt_bit = 0;
+            const Guard* alt_guard = nullptr;
+
+            friend class BarrierAltGuard;
+
+            static EventBits_t phaseBit(uint32_t phase) { return (EventBits_t)1 << (phase & 1); }
+            bool othersWaiting() const { return enrolled > 0 && arrived + 1 == enrolled; }
+
+            // Called with xCountMutex held.
+            void completePhase();
+            void wakeAltIfReady();
 
         public:
             /**
-             * @brief Constructs a barrier that requires N processes to synchronize.
-             * @param N The required number of processes.
+             * @brief Constructs a barrier that starts with N enrolled processes.
              */
-            Barrier(size_t N);
-            
+            constexpr Barrier(size_t N)
+                : enrolled(N), arrived(0), phases(0), xCountMutex(), xReleased() {}
+
+            Barrier(const Barrier&) = delete;
+            Barrier& operator=(const Barrier&) = delete;
+
             /**
-             * @brief Cleans up the FreeRTOS synchronization objects.
+             * @brief Blocks the calling task until all enrolled processes have arrived.
              */
-            ~Barrier();
+            void sync();
+
+            void enroll();
 
             /**
-             * @brief Blocks the calling task until all N processes have arrived.
+             * @brief Leaves the barrier; completes the current phase if everyone
+             * else is already waiting in it.
              */
-            void sync();
+            void resign();
+
+            uint32_t phase() const { return phases; }
+            size_t enrolledCount() const { return enrolled; }
+        };
+
+        /**
+         * @brief Processes fall into the bucket and wait there until another
+         * process flushes it; a flush releases all of them with one event-group
+         * broadcast, as Barrier does, and never blocks.
+         *
+         * Up to MAX_ALTS processes may also wait in the bucket from an ALT
+         * (BucketGuard): while the guard is enabled the process counts as held, and
+         * it becomes ready when the bucket is flushed. If the ALT selects another
+         * guard instead, the process leaves the bucket without being flushed.
+         *
+         * Unlike a barrier phase, flushes do not wait for the processes they
+         * release, so one that has not reached its wait yet can miss several. Each
+         * flush therefore gives the next fill its own event bit, and a bit is only
+         * reused once everyone released on it has left.
+         */
+        class Bucket {
+        public:
+            static const size_t MAX_ALTS = 4;
+            static const size_t FLUSH_SLOTS = 8;   // event bits cycled through by the flushes
+
+        private:
+            size_t held;
+            uint32_t flushes;
+
+            StaticMutex xMutex;
+            StaticEventGroup xReleased;        // Bit slot set by the flush that ends that fill
+            size_t slot;                       // bit the current fill waits on
+            size_t slot_waiters[FLUSH_SLOTS];  // tasks in fallInto() per bit, until they leave
+
+            struct AltWaiter {
+                AltScheduler* alt;
+                EventBits_t bit;
+                BucketAltGuard* guard;
+            };
+            AltWaiter alts[MAX_ALTS];
+            size_t num_alts;
+
+            friend class BucketAltGuard;
+
+            static EventBits_t slotBit(size_t n) { return (EventBits_t)1 << n; }
+
+        public:
+            constexpr Bucket()
+                : held(0), flushes(0), xMutex(), xReleased(), slot(0), slot_waiters{}, alts{}, num_alts(0) {}
+
+            Bucket(const Bucket&) = delete;
+            Bucket& operator=(const Bucket&) = delete;
+
+            /**
+             * @brief Blocks the calling task until the next flush().
+             */
+            void fallInto();
+
+            /**
+             * @brief Releases every process in the bucket.
+             * @return How many were released.
+             */
+            size_t flush();
+
+            size_t holding() const { return held; }
         };
 
     } // namespace csp::internal
-    
+
     // Alias in the main csp namespace for user-friendliness
     using Barrier = internal::Barrier;
-    
+    using Bucket = internal::Bucket;
+
+    /**
+     * @brief Offers to sync on a barrier from an ALT:
+     *
+     *     BarrierGuard step(barrier);
+     *     Alternative alt(step, cmd_in | cmd);
+     *     if (alt.priSelect() == 0) { ... }          // synced: a new phase began
+     */
+    class BarrierGuard : public Guard {
+    private:
+        internal::BarrierAltGuard guard_storage;
+    public:
+        explicit BarrierGuard(Barrier& b) : Guard(&guard_storage), guard_storage(&b) {}
+        BarrierGuard(const BarrierGuard&) = delete;
+        BarrierGuard& operator=(const BarrierGuard&) = delete;
+    };
+
+    /**
+     * @brief Waits in a bucket from an ALT; selected when the bucket is flushed.
+     */
+    class BucketGuard : public Guard {
+    private:
+        internal::BucketAltGuard guard_storage;
+    public:
+        explicit BucketGuard(Bucket& b) : Guard(&guard_storage), guard_storage(&b) {}
+        BucketGuard(const BucketGuard&) = delete;
+        BucketGuard& operator=(const BucketGuard&) = delete;
+    };
+
 } // namespace csp
 
 #endif // CSP4CMSIS_BARRIER_H
-
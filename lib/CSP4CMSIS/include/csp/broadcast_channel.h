@@ -0,0 +1,322 @@
+// --- broadcast_channel.h ---
+#ifndef CSP4CMSIS_BROADCAST_CHANNEL_H
+#define CSP4CMSIS_BROADCAST_CHANNEL_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "alt.h"
+#include "public_channel.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace csp {
+
+/**
+ * @brief How a BroadcastChannel paces its writer.
+ * Synchronous: a write returns once every reader has taken the value.
+ * Buffered:    each reader may lag up to Depth values; the writer only waits
+ *              when the slowest reader is Depth values behind.
+ */
+enum class BroadcastPolicy { Synchronous, Buffered };
+
+template <typename T, size_t MaxReaders, BroadcastPolicy Policy, size_t Depth>
+class BroadcastReader;
+
+namespace internal {
+
+    template <typename T, size_t MaxReaders, BroadcastPolicy Policy, size_t Depth>
+    class BroadcastReaderGuard;
+
+    /**
+     * @brief Shared state of a broadcast: a ring of Depth values and one read
+     * cursor per reader. A value is written into the ring once; each reader copies
+     * it out, and its slot is reused only after every reader has moved past it.
+     *
+     * The writer wakes the readers that are waiting (one notification each) and is
+     * itself woken once, by the reader whose progress lets it continue, however
+     * many readers there are.
+     */
+    template <typename T, size_t MaxReaders, BroadcastPolicy Policy, size_t Depth>
+    class BroadcastCore {
+        static_assert(MaxReaders > 0, "BroadcastChannel needs at least one reader");
+        static_assert(Depth > 0, "BroadcastChannel needs a depth of at least one");
+        static_assert(Policy == BroadcastPolicy::Buffered || Depth == 1,
+                      "BroadcastChannel: a synchronous broadcast holds exactly one value");
+
+    private:
+        T slots[Depth];
+        uint32_t written;                 // values published so far
+        uint32_t cursor[MaxReaders];      // values taken so far, per reader
+
+        TaskHandle_t reader_task[MaxReaders];
+        AltScheduler* reader_alt[MaxReaders];
+        EventBits_t reader_bit[MaxReaders];
+
+        TaskHandle_t writer_task;
+        uint32_t writer_needs;            // the writer continues once every cursor reaches this
+
+        // Called with interrupts masked.
+        uint32_t slowest() const {
+            uint32_t min = cursor[0];
+            for (size_t r = 1; r < MaxReaders; r++) {
+                if ((int32_t)(cursor[r] - min) < 0) min = cursor[r];
+            }
+            return min;
+        }
+
+        // Blocks the writer until every reader has taken `target` values.
+        void waitForReaders(uint32_t target) {
+            while (true) {
+                xTaskNotifyStateClear(NULL);
+                taskENTER_CRITICAL();
+                bool ok = (int32_t)(slowest() - target) >= 0;
+                if (!ok) {
+                    writer_task = xTaskGetCurrentTaskHandle();
+                    writer_needs = target;
+                }
+                taskEXIT_CRITICAL();
+                if (ok) return;
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+        }
+
+        // Called with interrupts masked once a value is published: takes the waiting readers.
+        size_t takeWaitingReaders(TaskHandle_t* tasks, AltScheduler** alts, EventBits_t* bits) {
+            size_t n = 0;
+            for (size_t r = 0; r < MaxReaders; r++) {
+                if (reader_task[r] != nullptr || reader_alt[r] != nullptr) {
+                    tasks[n] = reader_task[r];
+                    alts[n] = reader_alt[r];
+                    bits[n] = reader_bit[r];
+                    reader_task[r] = nullptr;
+                    n++;
+                }
+            }
+            return n;
+        }
+
+        friend class BroadcastReader<T, MaxReaders, Policy, Depth>;
+        friend class BroadcastReaderGuard<T, MaxReaders, Policy, Depth>;
+
+    public:
+        constexpr BroadcastCore()
+            : slots(), written(0), cursor{}, reader_task{}, reader_alt{}, reader_bit{},
+              writer_task(nullptr), writer_needs(0) {}
+
+        BroadcastCore(const BroadcastCore&) = delete;
+        BroadcastCore& operator=(const BroadcastCore&) = delete;
+
+        // --- Writer ---
+        void output(const T* const source) {
+            // Wait for the slot about to be reused to have been taken by every reader
+            waitForReaders(written + 1 - Depth);
+            slots[written % Depth] = *source;
+
+            TaskHandle_t tasks[MaxReaders];
+            AltScheduler* alts[MaxReaders];
+            EventBits_t bits[MaxReaders];
+
+            taskENTER_CRITICAL();
+            written++;
+            size_t n = takeWaitingReaders(tasks, alts, bits);
+            taskEXIT_CRITICAL();
+
+            for (size_t i = 0; i < n; i++) {
+                if (alts[i] != nullptr) alts[i]->wakeUp(bits[i]);
+                else xTaskNotifyGive(tasks[i]);
+            }
+
+            if (Policy == BroadcastPolicy::Synchronous) waitForReaders(written);
+        }
+
+        /**
+         * @brief Buffered policy only: publishes if no reader is Depth values
+         * behind, otherwise returns false.
+         */
+        bool putFromISR(const T& data) {
+            static_assert(Policy == BroadcastPolicy::Buffered,
+                          "putFromISR: an ISR cannot wait for the readers of a synchronous broadcast");
+            TaskHandle_t tasks[MaxReaders];
+            AltScheduler* alts[MaxReaders];
+            EventBits_t bits[MaxReaders];
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+            size_t n = 0;
+
+            UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+            bool space = (written - slowest()) < Depth;
+            if (space) {
+                slots[written % Depth] = data;
+                written++;
+                n = takeWaitingReaders(tasks, alts, bits);
+            }
+            taskEXIT_CRITICAL_FROM_ISR(saved);
+
+            for (size_t i = 0; i < n; i++) {
+                if (alts[i] != nullptr) alts[i]->wakeUp(bits[i]);
+                else vTaskNotifyGiveFromISR(tasks[i], &xHigherPriorityTaskWoken);
+            }
+            portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+            return space;
+        }
+
+    private:
+        // --- Readers ---
+        bool available(size_t r) {
+            taskENTER_CRITICAL();
+            bool ready = written != cursor[r];
+            taskEXIT_CRITICAL();
+            return ready;
+        }
+
+        void input(size_t r, T* dest) {
+            while (true) {
+                xTaskNotifyStateClear(NULL);
+                taskENTER_CRITICAL();
+                bool ready = written != cursor[r];
+                if (!ready) reader_task[r] = xTaskGetCurrentTaskHandle();
+                taskEXIT_CRITICAL();
+                if (ready) break;
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+            take(r, dest);
+        }
+
+        // Copies reader r's next value (one must be available) and advances its cursor.
+        void take(size_t r, T* dest) {
+            *dest = slots[cursor[r] % Depth];   // not reused until this reader has moved on
+
+            TaskHandle_t writer = nullptr;
+            taskENTER_CRITICAL();
+            cursor[r]++;
+            if (writer_task != nullptr && (int32_t)(slowest() - writer_needs) >= 0) {
+                writer = writer_task;
+                writer_task = nullptr;
+            }
+            taskEXIT_CRITICAL();
+
+            if (writer != nullptr) xTaskNotifyGive(writer);
+        }
+
+        bool registerAlt(size_t r, AltScheduler* alt, EventBits_t bit) {
+            taskENTER_CRITICAL();
+            bool ready = written != cursor[r];
+            if (!ready) {
+                reader_alt[r] = alt;
+                reader_bit[r] = bit;
+            }
+            taskEXIT_CRITICAL();
+            return ready;
+        }
+
+        bool unregisterAlt(size_t r) {
+            taskENTER_CRITICAL();
+            reader_alt[r] = nullptr;
+            bool ready = written != cursor[r];
+            taskEXIT_CRITICAL();
+            return ready;
+        }
+    };
+
+    template <typename T, size_t MaxReaders, BroadcastPolicy Policy, size_t Depth>
+    class BroadcastReaderGuard final : public Guard {
+    private:
+        BroadcastReader<T, MaxReaders, Policy, Depth>* reader;
+        T* dest_ptr = nullptr;
+
+    public:
+        explicit BroadcastReaderGuard(BroadcastReader<T, MaxReaders, Policy, Depth>* r) : reader(r) {}
+        void setTarget(T* dest) { dest_ptr = dest; }
+
+        bool enable(AltScheduler* alt, EventBits_t bit) override {
+            return reader->core->registerAlt(reader->index, alt, bit);
+        }
+        bool disable() override {
+            return reader->core->unregisterAlt(reader->index);
+        }
+        void activate() override {
+            reader->core->take(reader->index, dest_ptr);
+        }
+    };
+
+} // namespace internal
+
+/**
+ * @brief One subscriber of a BroadcastChannel: receives every value written.
+ */
+template <typename T, size_t MaxReaders, BroadcastPolicy Policy, size_t Depth>
+class BroadcastReader {
+private:
+    internal::BroadcastCore<T, MaxReaders, Policy, Depth>* core;
+    size_t index;
+    internal::BroadcastReaderGuard<T, MaxReaders, Policy, Depth> guard;
+
+    friend class internal::BroadcastReaderGuard<T, MaxReaders, Policy, Depth>;
+
+public:
+    using value_type = T;
+
+    BroadcastReader(internal::BroadcastCore<T, MaxReaders, Policy, Depth>* c, size_t i)
+        : core(c), index(i), guard(this) {}
+
+    BroadcastReader(const BroadcastReader& other)
+        : core(other.core), index(other.index), guard(this) {}
+
+    BroadcastReader& operator=(const BroadcastReader& other) {
+        core = other.core;
+        index = other.index;
+        return *this;
+    }
+
+    void operator>>(T& dest) { core->input(index, &dest); }
+    void read(T& dest) { core->input(index, &dest); }
+
+    bool pending() { return core->available(index); }
+
+    internal::Guard* getGuard(T& dest) {
+        guard.setTarget(&dest);
+        return &guard;
+    }
+};
+
+template <typename T, size_t MaxReaders, BroadcastPolicy Policy, size_t Depth>
+ChannelBinding<T, BroadcastReader<T, MaxReaders, Policy, Depth>>
+operator|(BroadcastReader<T, MaxReaders, Policy, Depth>& reader, T& dest) {
+    return ChannelBinding<T, BroadcastReader<T, MaxReaders, Policy, Depth>>(reader, dest);
+}
+
+/**
+ * @brief One writer, MaxReaders statically subscribed readers; every value written
+ * is delivered to all of them.
+ *
+ *     static BroadcastChannel<Result, 2> results;          // synchronous
+ *     static UI ui(results.reader(0));
+ *     static Led led(results.reader(1));
+ *     results.writer() << r;                               // returns once both have it
+ *
+ * All MaxReaders readers count as subscribed from the start and must keep
+ * reading, or the writer stalls. The writer end is an ordinary Chanout, so it can
+ * end a Fuse() chain.
+ */
+template <typename T, size_t MaxReaders,
+          BroadcastPolicy Policy = BroadcastPolicy::Synchronous, size_t Depth = 1>
+class BroadcastChannel {
+private:
+    internal::BroadcastCore<T, MaxReaders, Policy, Depth> core;
+
+public:
+    using Writer = Chanout<T, internal::BroadcastCore<T, MaxReaders, Policy, Depth>>;
+    using Reader = BroadcastReader<T, MaxReaders, Policy, Depth>;
+
+    constexpr BroadcastChannel() = default;
+
+    Writer writer() { return Writer(&core); }
+
+    Reader reader(size_t index) {
+        configASSERT(index < MaxReaders);
+        return Reader(&core, index);
+    }
+};
+
+} // namespace csp
+
+#endif // CSP4CMSIS_BROADCAST_CHANNEL_H
@@ -6,54 +6,84 @@
 #include "queue.h"
 #include "channel_base.h" 
 #include "alt.h"         
+#include "static_alloc.h"
 #include <cstdlib> 
+#include <type_traits>
 
 namespace csp::internal {
 
     template <typename T> class BufferedInputGuard;
     template <typename T> class BufferedOutputGuard;
+    template <typename T> class BufferedBatchInputGuard;
 
     template <typename T>
     class BufferedChannel : public internal::BaseAltChan<T>
     {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "Buffered channels store items in a FreeRTOS queue, which copies bytes: T must be trivially copyable");
+
     private:
-        QueueHandle_t queue_handle; 
+        StaticQueue queue; 
+        size_t capacity;
         
         // Use AltScheduler pointers to remain consistent with your Alt system
         AltScheduler* alt_reader = nullptr;
         EventBits_t   read_bit = 0;
+        UBaseType_t   alt_read_min = 1;     // elements needed before the ALTed reader is woken
         
         AltScheduler* alt_writer = nullptr;
         EventBits_t   write_bit = 0;
 
+        // A reader blocked in inputBatch(), notified once batch_min elements are queued
+        TaskHandle_t  batch_reader = nullptr;
+        UBaseType_t   batch_min = 0;
+
         BufferedInputGuard<T>  res_in_guard;
         BufferedOutputGuard<T> res_out_guard;
+        BufferedBatchInputGuard<T> res_batch_guard;
+
+        // Reader-side slot for the element held by an extended input; raw storage,
+        // so T needs no default constructor
+        alignas(T) unsigned char ext_slot[sizeof(T)] = {};
         
     public:
-        BufferedChannel(size_t capacity) 
-            : res_in_guard(this), res_out_guard(this) 
+        /**
+         * @param capacity Number of elements.
+         * @param storage  Statically allocated item storage of capacity * sizeof(T) bytes.
+         */
+        BufferedChannel(size_t capacity, uint8_t* storage) 
+            : queue(capacity, sizeof(T), storage), capacity(capacity),
+              res_in_guard(this), res_out_guard(this), res_batch_guard(this)
         {
-            if (capacity == 0) std::abort(); 
-            queue_handle = xQueueCreate(capacity, sizeof(T));
+            if (capacity == 0 || storage == nullptr) std::abort(); 
         }
 
-        ~BufferedChannel() override {
-            if (queue_handle) vQueueDelete(queue_handle);
-        }
+        ~BufferedChannel() override = default;
 
-        bool putFromISR(const T& data) override {
+        bool putFromISR(const T& data) final {
             BaseType_t xHigherPriorityTaskWoken = pdFALSE;
             bool success = false;
 
+            // The queue is created by the first task-side use; until then nobody can be reading
+            QueueHandle_t queue_handle = queue.created();
+            if (queue_handle == nullptr) return false;
+
             // 1. Attempt to send to queue without blocking
             if (xQueueSendFromISR(queue_handle, &data, &xHigherPriorityTaskWoken) == pdPASS) {
                 success = true;
                 
-                // 2. If a receiver is waiting in an ALT, wake them up
+                // 2. If a receiver is waiting in an ALT or a batch read, wake it once it has enough
                 // Note: AltScheduler::wakeUp already contains internal ISR-safe logic
-                if (alt_reader != nullptr) {
+                UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+                UBaseType_t waiting = uxQueueMessagesWaitingFromISR(queue_handle);
+                if (alt_reader != nullptr && waiting >= alt_read_min) {
                     alt_reader->wakeUp(read_bit);
                 }
+                if (batch_reader != nullptr && waiting >= batch_min) {
+                    vTaskNotifyGiveFromISR(batch_reader, &xHigherPriorityTaskWoken);
+                    batch_reader = nullptr;
+                }
+                taskEXIT_CRITICAL_FROM_ISR(saved);
             }
 
             // 3. Request context switch if a higher priority task was unblocked
@@ -63,49 +93,132 @@ namespace csp::internal {
 
         // --- Required by BaseAltChan ---
         // Matches the signature: virtual bool pending() = 0;
-        bool pending() override { 
-            return uxQueueMessagesWaiting(queue_handle) > 0; 
+        bool pending() final { 
+            return uxQueueMessagesWaiting(queue.get()) > 0; 
         } 
 
         bool space_available() { 
-            return uxQueueSpacesAvailable(queue_handle) > 0; 
+            return uxQueueSpacesAvailable(queue.get()) > 0; 
         }
 
         // --- Core I/O ---
-        void input(T* const dest) override {
-            if (xQueueReceive(queue_handle, dest, portMAX_DELAY) == pdPASS) {
+        void input(T* const dest) final {
+            if (xQueueReceive(queue.get(), dest, portMAX_DELAY) == pdPASS) {
                 // If a sender was ALTed waiting for space, wake them
-                taskENTER_CRITICAL();
-                if (alt_writer) alt_writer->wakeUp(write_bit);
-                taskEXIT_CRITICAL();
+                signalWriters();
             }
         }
 
         void output(const T* const source) override {
-            if (xQueueSend(queue_handle, source, portMAX_DELAY) == pdPASS) {
+            if (xQueueSend(queue.get(), source, portMAX_DELAY) == pdPASS) {
                 // If a receiver was ALTed waiting for data, wake them
+                signalReaders();
+            }
+        }
+
+        // --- Timed I/O: the queue wait itself is bounded ---
+        bool inputFor(T* const dest, TickType_t timeout) final {
+            if (xQueueReceive(queue.get(), dest, timeout) != pdPASS) return false;
+            signalWriters();
+            return true;
+        }
+
+        bool outputFor(const T* const source, TickType_t timeout) override {
+            if (xQueueSend(queue.get(), source, timeout) != pdPASS) return false;
+            signalReaders();
+            return true;
+        }
+
+        // --- Batch I/O ---
+        /**
+         * @brief Queues all count items, blocking only while the channel is full.
+         * Whatever fits is queued before readers are signalled, so a batch costs
+         * the reader one wake-up rather than one per element.
+         */
+        void outputBatch(const T* items, size_t count) {
+            size_t sent = 0;
+            while (true) {
+                while (sent < count && xQueueSend(queue.get(), &items[sent], 0) == pdPASS) sent++;
+                signalReaders();
+                if (sent == count) return;
+
+                // Full: wait for the reader to free one slot, then carry on filling
+                if (xQueueSend(queue.get(), &items[sent], portMAX_DELAY) == pdPASS) sent++;
+            }
+        }
+
+        /**
+         * @brief Takes between min_count and max_count items, blocking until at
+         * least min_count are available (min_count 0 never blocks).
+         * @return The number of items written to dest.
+         */
+        size_t inputBatch(T* dest, size_t max_count, size_t min_count) {
+            configASSERT(min_count <= max_count && min_count <= capacity);
+
+            size_t got = 0;
+            while (true) {
+                got += drain(dest + got, max_count - got);
+                if (got >= min_count) break;
+
+                // Sleep until the rest of the batch is queued: one notification, not one per element
+                xTaskNotifyStateClear(NULL);
                 taskENTER_CRITICAL();
-                if (alt_reader) alt_reader->wakeUp(read_bit);
+                bool ready = uxQueueMessagesWaiting(queue.get()) >= min_count - got;
+                if (!ready) {
+                    batch_reader = xTaskGetCurrentTaskHandle();
+                    batch_min = min_count - got;
+                }
                 taskEXIT_CRITICAL();
+                if (!ready) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
             }
+
+            if (got > 0) signalWriters();
+            return got;
+        }
+
+        /**
+         * @brief Non-blocking receive of up to max_count queued items.
+         */
+        size_t drain(T* dest, size_t max_count) {
+            size_t got = 0;
+            while (got < max_count && xQueueReceive(queue.get(), &dest[got], 0) == pdPASS) got++;
+            return got;
         }
 
-        void beginExtInput(T* const dest) override { this->input(dest); }
-        void endExtInput() override { }
+        // Extended input: the queue copies bytes out, so the head element is received
+        // once into a channel-owned slot, the same single copy as input(). ALTed
+        // writers are only signalled in endExtInput(); a writer blocked on a full
+        // queue can refill the freed slot straight away, so there is no extra
+        // back-pressure beyond the buffer itself.
+        const T* beginExtInput() override {
+            xQueueReceive(queue.get(), ext_slot, portMAX_DELAY);
+            return reinterpret_cast<const T*>(ext_slot);
+        }
+        void endExtInput() override { signalWriters(); }
         
-        Guard* getInputGuard(T& dest) override {
+        Guard* getInputGuard(T& dest) final {
             res_in_guard.setTarget(&dest);
             return &res_in_guard;
         }
 
-        Guard* getOutputGuard(const T& source) override {
+        Guard* getOutputGuard(const T& source) final {
             res_out_guard.setTarget(&source);
             return &res_out_guard;
         }
+
+        Guard* getBatchInputGuard(T* dest, size_t max_count, size_t min_count, size_t* count) {
+            configASSERT(min_count > 0 && min_count <= max_count && min_count <= capacity);
+            res_batch_guard.setTarget(dest, max_count, min_count, count);
+            return &res_batch_guard;
+        }
+
+        bool available(size_t min_count) {
+            return uxQueueMessagesWaiting(queue.get()) >= min_count;
+        }
         
         // Registration Helpers
-        void registerInputAlt(AltScheduler* alt, EventBits_t b) {
-            taskENTER_CRITICAL(); alt_reader = alt; read_bit = b; taskEXIT_CRITICAL();
+        void registerInputAlt(AltScheduler* alt, EventBits_t b, UBaseType_t min_count = 1) {
+            taskENTER_CRITICAL(); alt_reader = alt; read_bit = b; alt_read_min = min_count; taskEXIT_CRITICAL();
         }
         void unregisterInputAlt() {
             taskENTER_CRITICAL(); alt_reader = nullptr; taskEXIT_CRITICAL();
@@ -117,14 +230,44 @@ namespace csp::internal {
             taskENTER_CRITICAL(); alt_writer = nullptr; taskEXIT_CRITICAL();
         }
 
-        QueueHandle_t getQueueHandle() const { return queue_handle; }
+        QueueHandle_t getQueueHandle() { return queue.get(); }
+
+    protected:
+        // Called by writers after queuing: wakes an ALTed or batch reader that now has enough
+        void signalReaders() {
+            taskENTER_CRITICAL();
+            UBaseType_t waiting = uxQueueMessagesWaiting(queue.get());
+            if (alt_reader != nullptr && waiting >= alt_read_min) alt_reader->wakeUp(read_bit);
+            if (batch_reader != nullptr && waiting >= batch_min) {
+                xTaskNotifyGive(batch_reader);
+                batch_reader = nullptr;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        // Called by readers after dequeuing: wakes an ALTed writer waiting for space
+        void signalWriters() {
+            taskENTER_CRITICAL();
+            if (alt_writer) alt_writer->wakeUp(write_bit);
+            taskEXIT_CRITICAL();
+        }
+    };
+
+    /**
+     * @brief Plain FIFO leaf of BufferedChannel. Being final, ends typed on it
+     * resolve output()/beginExtInput() statically as well.
+     */
+    template <typename T>
+    class FifoChannel final : public BufferedChannel<T> {
+    public:
+        FifoChannel(size_t capacity, uint8_t* storage) : BufferedChannel<T>(capacity, storage) {}
     };
     
     // =============================================================
     // Guards (Updated to use AltScheduler* pointer directly)
     // =============================================================
     template <typename T>
-    class BufferedInputGuard : public Guard {
+    class BufferedInputGuard final : public Guard {
     private:
         BufferedChannel<T>* channel;
         T* dest_ptr = nullptr; 
@@ -146,8 +289,40 @@ namespace csp::internal {
         }
     };
     
+    /**
+     * @brief Input guard of a batch read: ready once min_count elements are queued,
+     * and takes up to max_count of them when selected.
+     */
+    template <typename T>
+    class BufferedBatchInputGuard final : public Guard {
+    private:
+        BufferedChannel<T>* channel;
+        T* dest_ptr = nullptr;
+        size_t max_count = 0;
+        size_t min_count = 1;
+        size_t* count_ptr = nullptr;
+    public:
+        BufferedBatchInputGuard(BufferedChannel<T>* chan) : channel(chan) {}
+        void setTarget(T* dest, size_t max, size_t min, size_t* count) {
+            dest_ptr = dest; max_count = max; min_count = min; count_ptr = count;
+        }
+
+        bool enable(AltScheduler* alt, EventBits_t bit) override {
+            if (channel->available(min_count)) return true;
+            channel->registerInputAlt(alt, bit, min_count);
+            return false;
+        }
+        bool disable() override {
+            channel->unregisterInputAlt();
+            return channel->available(min_count);
+        }
+        void activate() override {
+            *count_ptr = channel->inputBatch(dest_ptr, max_count, 0);
+        }
+    };
+    
     template <typename T>
-    class BufferedOutputGuard : public Guard {
+    class BufferedOutputGuard final : public Guard {
     private:
         BufferedChannel<T>* channel;
         const T* source_ptr = nullptr;
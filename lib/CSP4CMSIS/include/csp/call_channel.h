@@ -0,0 +1,100 @@
+// --- call_channel.h ---
+#ifndef CSP4CMSIS_CALL_CHANNEL_H
+#define CSP4CMSIS_CALL_CHANNEL_H
+
+#include "rendezvous_channel.h"
+
+namespace csp {
+
+namespace internal {
+
+    // What travels through the rendezvous: the client's own request and reply objects
+    template <typename Req, typename Resp>
+    struct CallSlot {
+        const Req* request;
+        Resp* reply;
+    };
+
+} // namespace internal
+
+/**
+ * @brief Request/reply between a client and a server process in one hand-off:
+ *
+ *     static CallChannel<StatsQuery, Stats> stats;
+ *
+ *     Stats s;
+ *     client.call(StatsQuery{ reset }, s);        // blocks until the server replied
+ *
+ *     server.accept([&](const StatsQuery& q, Stats& reply) {
+ *         reply = current;                       // written into the client's object
+ *     });
+ *
+ * The call is an extended rendezvous on a pointer pair: accept() runs the handler
+ * on the client's request in place, the handler fills in the client's reply, and
+ * only then is the client released. Neither object is copied, and the client
+ * blocks once. The server may ALT on incoming calls with acceptGuard(); when that
+ * guard is selected, accept() finds the client waiting and does not block.
+ *
+ * One client and one server at a time, as for One2OneChannel. There is no timed
+ * call: a client that gave up could not stop a server already writing its reply.
+ */
+template <typename Req, typename Resp>
+class CallChannel;
+
+template <typename Req, typename Resp>
+class CallClient {
+private:
+    internal::RendezvousChannel<internal::CallSlot<Req, Resp>>* channel;
+
+public:
+    explicit CallClient(internal::RendezvousChannel<internal::CallSlot<Req, Resp>>* chan) : channel(chan) {}
+
+    void call(const Req& request, Resp& reply) {
+        const internal::CallSlot<Req, Resp> slot{ &request, &reply };
+        channel->output(&slot);
+    }
+};
+
+template <typename Req, typename Resp>
+class CallServer {
+private:
+    internal::RendezvousChannel<internal::CallSlot<Req, Resp>>* channel;
+
+public:
+    explicit CallServer(internal::RendezvousChannel<internal::CallSlot<Req, Resp>>* chan) : channel(chan) {}
+
+    /**
+     * @brief Waits for a call and runs handler(const Req&, Resp&) on it; the
+     * client is released when the handler returns.
+     */
+    template <typename F>
+    void accept(F&& handler) {
+        const internal::CallSlot<Req, Resp>* slot = channel->beginExtInput();
+        handler(*slot->request, *slot->reply);
+        channel->endExtInput();
+    }
+
+    /**
+     * @brief ALT guard, ready while a client waits in call(). Selecting it takes
+     * nothing; follow it with accept().
+     */
+    internal::Guard* acceptGuard() { return channel->getPendingInputGuard(); }
+};
+
+template <typename Req, typename Resp>
+class CallChannel {
+private:
+    internal::RendezvousChannel<internal::CallSlot<Req, Resp>> internal_chan;
+public:
+    using Client = CallClient<Req, Resp>;
+    using Server = CallServer<Req, Resp>;
+
+    constexpr CallChannel() = default;
+
+    Client client() { return Client(&internal_chan); }
+    Server server() { return Server(&internal_chan); }
+};
+
+} // namespace csp
+
+#endif // CSP4CMSIS_CALL_CHANNEL_H
@@ -2,11 +2,19 @@
 #ifndef CSP4CMSIS_CHANNEL_BASE_H
 #define CSP4CMSIS_CHANNEL_BASE_H
 
+#include "FreeRTOS.h"
 #include <stddef.h> 
 
 namespace csp {
-    template <typename T> class Chanin;
-    template <typename T> class Chanout;
+    namespace internal {
+        template <typename DATA_TYPE> class BaseAltChan;
+    }
+
+    // Channel ends. Chan is the channel class the end calls into: the type-erased
+    // BaseAltChan<T> by default, or a concrete (final) channel so the hand-off
+    // path is resolved at compile time.
+    template <typename T, typename Chan = internal::BaseAltChan<T>> class Chanin;
+    template <typename T, typename Chan = internal::BaseAltChan<T>> class Chanout;
     class Alternative; 
 }
 
@@ -21,10 +29,10 @@ namespace csp::internal {
     class BaseChan 
     {
     public:
-        template <typename U>
+        template <typename U, typename C>
         friend class csp::Chanin; 
 
-        template <typename U>
+        template <typename U, typename C>
         friend class csp::Chanout;
         
     protected:
@@ -32,8 +40,19 @@ namespace csp::internal {
 
         virtual void input(DATA_TYPE* const dest) = 0;
         virtual void output(const DATA_TYPE* const source) = 0;
+
+        /**
+         * @brief Output of a value the writer gave up (an rvalue). Channels that
+         * hand over by assignment move from it; the rest copy.
+         */
+        virtual void outputMove(DATA_TYPE* const source) { output(source); }
         
-        virtual void beginExtInput(DATA_TYPE* const dest) = 0;
+        /**
+         * @brief Extended input: blocks until a writer is ready and returns a
+         * pointer to its data. On a rendezvous channel the writer stays blocked
+         * until endExtInput(); buffered channels hand out a copy of the element.
+         */
+        virtual const DATA_TYPE* beginExtInput() = 0;
         virtual void endExtInput() = 0;
     }; 
     
@@ -50,6 +69,13 @@ namespace csp::internal {
          */
         virtual bool pending() = 0;
         virtual bool putFromISR(const DATA_TYPE& data) = 0;
+
+        /**
+         * @brief Input/output that give up after timeout ticks (0: only if a partner
+         * or data is ready now). Return false if nothing was transferred.
+         */
+        virtual bool inputFor(DATA_TYPE* const dest, TickType_t timeout) = 0;
+        virtual bool outputFor(const DATA_TYPE* const source, TickType_t timeout) = 0;
         virtual internal::Guard* getInputGuard(DATA_TYPE& dest) = 0;
         virtual internal::Guard* getOutputGuard(const DATA_TYPE& source) = 0;
         
@@ -0,0 +1,321 @@
+// --- coro.h ---
+#ifndef CSP4CMSIS_CORO_H
+#define CSP4CMSIS_CORO_H
+
+/**
+ * Opt-in stackless executor: CSP processes written as C++20 coroutines and
+ * multiplexed on one FreeRTOS task (one TCB, one stack).
+ *
+ * A coro::Group is an ordinary CSProcess, so it sits in InParallel/Run next to
+ * task-based processes. Inside the group, coro::Channel reads, writes and ALTs
+ * are co_await points, and a hand-off is a plain resumption of the partner
+ * coroutine, with no kernel call and no context switch.
+ *
+ * Only available when the compiler implements coroutines (-std=gnu++20);
+ * CSP_HAS_COROUTINES tells the application which mode it is built in.
+ * A coroutine that uses an ordinary csp::Channel blocks its whole group.
+ */
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define CSP_HAS_COROUTINES 1
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "process.h"
+#include <coroutine>
+#include <stddef.h>
+#include <tuple>
+#include <utility>
+
+// Static arena all coroutine frames are carved from (never the heap).
+#ifndef CSP_CORO_ARENA_BYTES
+#define CSP_CORO_ARENA_BYTES 4096
+#endif
+
+namespace csp::coro {
+
+    class Executor;
+
+    namespace internal {
+        /**
+         * @brief Bump allocator over a static arena. Rewound once every frame
+         * has been freed, i.e. when all groups have finished.
+         * Returns nullptr when the arena is exhausted.
+         */
+        void* frame_alloc(size_t size) noexcept;
+        void frame_free(void* frame) noexcept;
+    } // namespace internal
+
+    /**
+     * @brief Return type of a coroutine process:
+     * coro::Process relay(coro::Channel<int>& in, coro::Channel<int>& out) { ... }
+     * The body starts when the process is spawned on a group.
+     */
+    class Process {
+    public:
+        struct promise_type {
+            Executor* executor = nullptr;
+
+            Process get_return_object() noexcept {
+                return Process(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+            static Process get_return_object_on_allocation_failure() noexcept { return Process(nullptr); }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; } // destroyed by the executor
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { configASSERT(pdFALSE); }
+
+            static void* operator new(size_t size) noexcept { return internal::frame_alloc(size); }
+            static void operator delete(void* frame) noexcept { internal::frame_free(frame); }
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Process(Process&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+        Process(const Process&) = delete;
+        Process& operator=(const Process&) = delete;
+        ~Process() { if (handle) handle.destroy(); }
+
+    private:
+        explicit Process(Handle h) : handle(h) {}
+
+        Handle release() { Handle h = handle; handle = nullptr; return h; }
+
+        Handle handle;
+
+        friend class Executor;
+    };
+
+    /**
+     * @brief Ready queue of one group. Every process is either running, parked on
+     * a channel, or queued here once, so the ring never needs more slots than
+     * the group has processes.
+     */
+    class Executor {
+    private:
+        Process::Handle* ring;
+        size_t capacity;
+        size_t head = 0;
+        size_t count = 0;
+        size_t live = 0;
+
+    protected:
+        Executor(Process::Handle* storage, size_t slots) : ring(storage), capacity(slots) {}
+
+    public:
+        Executor(const Executor&) = delete;
+        Executor& operator=(const Executor&) = delete;
+
+        /**
+         * @brief Takes ownership of a process and queues its first resumption.
+         */
+        void spawn(Process&& process);
+
+        /**
+         * @brief Queues a parked process for resumption (called by channels).
+         */
+        void schedule(Process::Handle h);
+
+        /**
+         * @brief Resumes ready processes until none is left. Returns the number of
+         * processes still parked (non-zero means the group deadlocked).
+         */
+        size_t drive();
+    };
+
+    /**
+     * @brief A group of up to MaxProcesses coroutine processes on one task.
+     */
+    template <size_t MaxProcesses, size_t StackWords = CSP_DEFAULT_STACK_WORDS>
+    class Group : public CSProcessWithStack<StackWords>, public Executor {
+    private:
+        Process::Handle slots[MaxProcesses];
+
+    public:
+        Group() : Executor(slots, MaxProcesses), slots{} {}
+
+        const char* name() const override { return "csp_coro"; }
+
+        void run() override { drive(); }
+    };
+
+    template <typename T> class Channel;
+
+    namespace internal {
+        /**
+         * @brief A parked ALT: the first writer to reach one of its channels
+         * delivers into that guard's destination and records the index.
+         */
+        struct AltWaiter {
+            Process::Handle handle;
+            int selected;
+        };
+    } // namespace internal
+
+    /**
+     * @brief Input guard for coro::alt, written chan | dest as for Alternative.
+     */
+    template <typename T>
+    struct InGuard {
+        Channel<T>& channel;
+        T& dest;
+    };
+
+    /**
+     * @brief Unbuffered one-to-one channel between processes of the same group.
+     * No kernel objects: a parked partner is a coroutine handle.
+     */
+    template <typename T>
+    class Channel {
+    private:
+        Process::Handle reader = nullptr;
+        T* read_dest = nullptr;
+
+        Process::Handle writer = nullptr;
+        const T* write_src = nullptr;
+
+        internal::AltWaiter* alt = nullptr;
+        int alt_index = 0;
+        T* alt_dest = nullptr;
+
+        static Executor& executor_of(Process::Handle h) { return *h.promise().executor; }
+
+        class ReadAwaiter {
+            Channel& chan;
+            T& dest;
+        public:
+            ReadAwaiter(Channel& c, T& d) : chan(c), dest(d) {}
+
+            bool await_ready() noexcept {
+                if (!chan.writer) return false;
+                chan.takeFromWriter(dest);
+                return true;
+            }
+            void await_suspend(Process::Handle h) noexcept {
+                chan.reader = h;
+                chan.read_dest = &dest;
+            }
+            void await_resume() noexcept {}
+        };
+
+        class WriteAwaiter {
+            Channel& chan;
+            const T& value;
+        public:
+            WriteAwaiter(Channel& c, const T& v) : chan(c), value(v) {}
+
+            bool await_ready() noexcept {
+                if (chan.reader) {
+                    *chan.read_dest = value;
+                    executor_of(chan.reader).schedule(chan.reader);
+                    chan.reader = nullptr;
+                    return true;
+                }
+                // An ALT that has already been chosen by another guard is no partner.
+                if (chan.alt && chan.alt->selected < 0) {
+                    *chan.alt_dest = value;
+                    chan.alt->selected = chan.alt_index;
+                    executor_of(chan.alt->handle).schedule(chan.alt->handle);
+                    return true;
+                }
+                return false;
+            }
+            void await_suspend(Process::Handle h) noexcept {
+                chan.writer = h;
+                chan.write_src = &value;
+            }
+            void await_resume() noexcept {}
+        };
+
+    public:
+        constexpr Channel() = default;
+        Channel(const Channel&) = delete;
+        Channel& operator=(const Channel&) = delete;
+
+        /** co_await chan.read(x); */
+        ReadAwaiter read(T& dest) { return ReadAwaiter(*this, dest); }
+
+        /** co_await chan.write(x); completes once the reader has the value. */
+        WriteAwaiter write(const T& value) { return WriteAwaiter(*this, value); }
+
+        InGuard<T> operator|(T& dest) { return InGuard<T>{ *this, dest }; }
+
+        // Used by AltAwaiter.
+        bool writerWaiting() const { return writer != nullptr; }
+        void takeFromWriter(T& dest) {
+            dest = *write_src;
+            executor_of(writer).schedule(writer);
+            writer = nullptr;
+        }
+        void armAlt(internal::AltWaiter* w, int index, T* dest) { alt = w; alt_index = index; alt_dest = dest; }
+        void disarmAlt() { alt = nullptr; }
+    };
+
+    /**
+     * @brief Awaiter returned by coro::alt. Priority select: the lowest-index ready
+     * guard wins; the value is already in its destination when co_await returns.
+     */
+    template <typename... Ts>
+    class Alt {
+    private:
+        static constexpr size_t N = sizeof...(Ts);
+        std::tuple<InGuard<Ts>...> guards;
+        internal::AltWaiter waiter{ nullptr, -1 };
+
+        template <size_t I = 0>
+        int poll() {
+            if constexpr (I < N) {
+                auto& g = std::get<I>(guards);
+                if (g.channel.writerWaiting()) {
+                    g.channel.takeFromWriter(g.dest);
+                    return (int)I;
+                }
+                return poll<I + 1>();
+            } else {
+                return -1;
+            }
+        }
+
+        template <size_t... I>
+        void arm(std::index_sequence<I...>) {
+            (std::get<I>(guards).channel.armAlt(&waiter, (int)I, &std::get<I>(guards).dest), ...);
+        }
+
+        template <size_t... I>
+        void disarm(std::index_sequence<I...>) {
+            (std::get<I>(guards).channel.disarmAlt(), ...);
+        }
+
+    public:
+        explicit Alt(InGuard<Ts>... g) : guards(g...) {}
+
+        bool await_ready() noexcept {
+            waiter.selected = poll();
+            return waiter.selected >= 0;
+        }
+        void await_suspend(Process::Handle h) noexcept {
+            waiter.handle = h;
+            arm(std::index_sequence_for<Ts...>{});
+        }
+        int await_resume() noexcept {
+            disarm(std::index_sequence_for<Ts...>{});
+            return waiter.selected;
+        }
+    };
+
+    /**
+     * @brief int i = co_await coro::alt(a | x, b | y);
+     */
+    template <typename... Ts>
+    Alt<Ts...> alt(InGuard<Ts>... guards) {
+        return Alt<Ts...>(guards...);
+    }
+
+} // namespace csp::coro
+
+#else
+#define CSP_HAS_COROUTINES 0
+#endif // __cpp_impl_coroutine
+
+#endif // CSP4CMSIS_CORO_H
@@ -22,8 +22,14 @@ namespace csp { /* Forward declare namespace content here if needed */ }
 #include "buffered_channel.h"// For future implementation
 #include "barrier.h"         // Standard CSP primitive
 #include "public_channel.h"  // Includes One2OneChannel<T>
+#include "shared_channel.h"  // Any2One/One2Any/Any2Any rendezvous channels
+#include "state_channel.h"   // StateChannel<T>: latest value, many readers
+#include "broadcast_channel.h" // BroadcastChannel<T, N>: every value to N readers
+#include "isr_event_channel.h" // IsrEventChannel<T, N>: many ISRs, one consumer
+#include "call_channel.h"    // CallChannel<Req, Resp>: request/reply in one hand-off
 #include "public_task.h"     // Includes CSProcess, Run() function
 #include "run.h"             // <--- NEW: Includes InParallel/InSequence helpers
+#include "pipeline.h"        // Fuse(): linear stage chains in one task
 
 // Note: The file public_task.h should now contain the definition/declaration 
 // of the base Run(CSProcess&, UBaseType_t) function signature.
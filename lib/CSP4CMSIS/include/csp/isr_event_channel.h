@@ -0,0 +1,309 @@
+// --- isr_event_channel.h ---
+#ifndef CSP4CMSIS_ISR_EVENT_CHANNEL_H
+#define CSP4CMSIS_ISR_EVENT_CHANNEL_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "alt.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+namespace csp {
+
+/**
+ * @brief Many interrupt sources, one consumer task: a bounded ring that any ISR
+ * posts small events into, each tagged by the caller (a source id, a timestamp).
+ *
+ *     struct IrqEvent { uint8_t source; uint32_t cycles; };
+ *     static IsrEventChannel<IrqEvent, 16> irq_events;
+ *
+ *     irq_events.writer().putFromISR({ SRC_BUTTON, DWT->CYCCNT });   // any ISR
+ *
+ *     IrqEvent batch[8];
+ *     size_t n = rd.read(batch);                                   // 1..8 events
+ *
+ * Posting is lock-free: a producer claims a slot with one compare-and-swap on the
+ * tail and publishes it with a per-slot sequence stamp, so nested interrupts
+ * posting at once never mask each other and never wait. A full ring rejects the
+ * event and counts it in overflows(). maxDepth() is the fullest the ring has been.
+ *
+ * The consumer is woken with a task notification (or its ALT's event bit), so ISRs
+ * that post must be allowed to call FreeRTOS, as for every channel.
+ */
+template <typename T, size_t SIZE>
+class IsrEventChannel;
+
+template <typename T, size_t SIZE>
+class IsrEventReader {
+private:
+    IsrEventChannel<T, SIZE>* channel;
+
+public:
+    explicit IsrEventReader(IsrEventChannel<T, SIZE>* chan) : channel(chan) {}
+
+    void operator>>(T& dest) { read(dest); }
+
+    void read(T& dest) {
+        TickType_t forever = portMAX_DELAY;
+        channel->input(&dest, forever);
+    }
+
+    bool read_for(T& dest, Time timeout) {
+        TickType_t ticks = timeout.to_ticks();
+        return channel->input(&dest, ticks);
+    }
+
+    bool try_read(T& dest) {
+        TickType_t none = 0;
+        return channel->input(&dest, none);
+    }
+
+    /**
+     * @brief Blocks until at least min_count events are queued, then takes up to
+     * max_count in one go.
+     * @return The number of events read.
+     */
+    size_t read(T* dest, size_t max_count, size_t min_count = 1) {
+        return channel->inputBatch(dest, max_count, min_count);
+    }
+
+    template <size_t N>
+    size_t read(T (&dest)[N], size_t min_count = 1) {
+        return channel->inputBatch(dest, N, min_count);
+    }
+
+    uint32_t maxDepth() const { return channel->maxDepth(); }
+    uint32_t overflows() const { return channel->overflows(); }
+
+    internal::Guard* getGuard(T& dest) {
+        channel->res_guard.setTarget(&dest);
+        return &channel->res_guard;
+    }
+};
+
+template <typename T, size_t SIZE>
+class IsrEventWriter {
+private:
+    IsrEventChannel<T, SIZE>* channel;
+
+public:
+    explicit IsrEventWriter(IsrEventChannel<T, SIZE>* chan) : channel(chan) {}
+
+    /**
+     * @return false if the ring was full (the event is counted in overflows()).
+     */
+    bool putFromISR(const T& data) { return channel->putFromISR(data); }
+};
+
+namespace internal {
+
+    /**
+     * @brief ALT guard of an IsrEventChannel's reader: ready while an event is queued.
+     */
+    template <typename T, size_t SIZE>
+    class IsrEventGuard final : public Guard {
+    private:
+        IsrEventChannel<T, SIZE>* channel;
+        T* dest_ptr = nullptr;
+
+    public:
+        explicit IsrEventGuard(IsrEventChannel<T, SIZE>* chan) : channel(chan) {}
+        void setTarget(T* dest) { dest_ptr = dest; }
+
+        bool enable(AltScheduler* alt, EventBits_t bit) override {
+            channel->registerAlt(alt, bit);
+            return channel->ready(1);
+        }
+        bool disable() override {
+            channel->unregisterAlt();
+            return channel->ready(1);
+        }
+        // A producer can wake the ALT late, for an event a previous select already
+        // took; then the next event is waited for rather than returning none.
+        void activate() override {
+            TickType_t forever = portMAX_DELAY;
+            channel->input(dest_ptr, forever);
+        }
+    };
+
+} // namespace internal
+
+template <typename T, size_t SIZE>
+class IsrEventChannel {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "IsrEventChannel: events are copied in interrupt context; T must be trivially copyable");
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0,
+                  "IsrEventChannel: SIZE must be a power of two, at least 2");
+
+private:
+    static constexpr uint32_t MASK = SIZE - 1;
+
+    // stamp holds the slot's sequence number minus its index, so that all-zero is
+    // the initial state: free for position p when stamp == lap(p), published when
+    // stamp == lap(p) + 1, and freed for the next lap with lap(p) + SIZE.
+    struct Slot {
+        std::atomic<uint32_t> stamp;
+        T value;
+    };
+
+    static constexpr uint32_t lap(uint32_t pos) { return pos & ~MASK; }
+
+    Slot slots[SIZE];
+    std::atomic<uint32_t> tail;           // next position a producer claims
+    std::atomic<uint32_t> head;           // next position the consumer reads
+
+    std::atomic<uint32_t> max_depth;
+    std::atomic<uint32_t> overflow_count;
+
+    // The consumer, blocked until reader_min events have been posted
+    std::atomic<TaskHandle_t> reader_task;
+    std::atomic<uint32_t> reader_min;
+
+    std::atomic<internal::AltScheduler*> alt_reader;
+    EventBits_t alt_bit;
+
+    internal::IsrEventGuard<T, SIZE> res_guard;   // there is only one consumer
+
+    friend class IsrEventReader<T, SIZE>;
+    friend class IsrEventWriter<T, SIZE>;
+    friend class internal::IsrEventGuard<T, SIZE>;
+
+public:
+    using Reader = IsrEventReader<T, SIZE>;
+    using Writer = IsrEventWriter<T, SIZE>;
+
+    constexpr IsrEventChannel()
+        : slots(), tail(0), head(0), max_depth(0), overflow_count(0),
+          reader_task(nullptr), reader_min(1), alt_reader(nullptr), alt_bit(0), res_guard(this) {}
+
+    IsrEventChannel(const IsrEventChannel&) = delete;
+    IsrEventChannel& operator=(const IsrEventChannel&) = delete;
+
+    Writer writer() { return Writer(this); }
+    Reader reader() { return Reader(this); }
+
+    uint32_t maxDepth() const { return max_depth.load(std::memory_order_relaxed); }
+    uint32_t overflows() const { return overflow_count.load(std::memory_order_relaxed); }
+
+private:
+    // --- Producers (any ISR) ---
+    bool putFromISR(const T& data) {
+        uint32_t pos = tail.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots[pos & MASK];
+            int32_t diff = (int32_t)(slot->stamp.load(std::memory_order_acquire) - lap(pos));
+            if (diff == 0) {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                // The consumer has not freed this slot since the last lap: full
+                overflow_count.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = tail.load(std::memory_order_relaxed);   // another producer took it
+            }
+        }
+        slot->value = data;
+        slot->stamp.store(lap(pos) + 1, std::memory_order_release);
+
+        uint32_t depth = pos + 1 - head.load(std::memory_order_relaxed);
+        uint32_t seen = max_depth.load(std::memory_order_relaxed);
+        while (depth > seen && !max_depth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {}
+
+        // Pairs with the fence in waitFor(): either we see the reader, or it sees the event
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        if (depth >= reader_min.load(std::memory_order_relaxed)) {
+            TaskHandle_t reader = reader_task.exchange(nullptr);
+            if (reader != nullptr) vTaskNotifyGiveFromISR(reader, &xHigherPriorityTaskWoken);
+        }
+        internal::AltScheduler* alt = alt_reader.load(std::memory_order_acquire);
+        if (alt != nullptr) alt->wakeUp(alt_bit);
+
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return true;
+    }
+
+    // --- Consumer (one task) ---
+    bool pop(T* dest) {
+        uint32_t pos = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[pos & MASK];
+        if (slot.stamp.load(std::memory_order_acquire) != lap(pos) + 1) return false;
+        *dest = slot.value;
+        slot.stamp.store(lap(pos) + SIZE, std::memory_order_release);
+        head.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t drain(T* dest, size_t max_count) {
+        size_t got = 0;
+        while (got < max_count && pop(&dest[got])) got++;
+        return got;
+    }
+
+    // At least min posted and the oldest one published.
+    bool ready(uint32_t min) const {
+        uint32_t pos = head.load(std::memory_order_relaxed);
+        return tail.load(std::memory_order_relaxed) - pos >= min &&
+               slots[pos & MASK].stamp.load(std::memory_order_acquire) == lap(pos) + 1;
+    }
+
+    // Blocks until ready(min) or the timeout, leaving in timeout what is left of it.
+    bool waitFor(uint32_t min, TickType_t& timeout) {
+        TimeOut_t start;
+        vTaskSetTimeOutState(&start);
+
+        while (true) {
+            if (ready(min)) return true;
+            if (timeout == 0 || xTaskCheckForTimeOut(&start, &timeout) == pdTRUE) return false;
+
+            reader_min.store(min, std::memory_order_relaxed);
+            reader_task.store(xTaskGetCurrentTaskHandle(), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            bool notified = !ready(min) && ulTaskNotifyTake(pdTRUE, timeout) != 0;
+            if (!notified && reader_task.exchange(nullptr) == nullptr) {
+                // A producer took the registration: its notification is on its way
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            }
+        }
+    }
+
+    bool input(T* dest, TickType_t& timeout) {
+        while (!pop(dest)) {
+            if (!waitFor(1, timeout)) return false;
+        }
+        return true;
+    }
+
+    size_t inputBatch(T* dest, size_t max_count, size_t min_count) {
+        configASSERT(min_count <= max_count && min_count <= SIZE);
+        size_t got = drain(dest, max_count);
+        while (got < min_count) {
+            TickType_t forever = portMAX_DELAY;
+            waitFor((uint32_t)(min_count - got), forever);
+            got += drain(dest + got, max_count - got);
+        }
+        return got;
+    }
+
+    void registerAlt(internal::AltScheduler* alt, EventBits_t bit) {
+        alt_bit = bit;
+        alt_reader.store(alt, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void unregisterAlt() { alt_reader.store(nullptr); }
+};
+
+template <typename T, size_t SIZE>
+ChannelBinding<T, IsrEventReader<T, SIZE>> operator|(IsrEventReader<T, SIZE>& reader, T& dest) {
+    return ChannelBinding<T, IsrEventReader<T, SIZE>>(reader, dest);
+}
+
+} // namespace csp
+
+#endif // CSP4CMSIS_ISR_EVENT_CHANNEL_H
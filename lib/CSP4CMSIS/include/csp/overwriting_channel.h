@@ -1,53 +1,275 @@
-// --- overwriting_channel.h (Time Sync Removed / Simplified) ---
+// --- overwriting_channel.h ---
 #ifndef CSP4CMSIS_OVERWRITING_CHANNEL_H
 #define CSP4CMSIS_OVERWRITING_CHANNEL_H
 
-#include "buffered_channel.h"
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "task.h"
+#include "channel_base.h"
+#include "alt.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
 
 namespace csp::internal {
 
+template <typename T> class OverwritingInputGuard;
+template <typename T> class OverwritingOutputGuard;
+
 /**
- * @brief A Buffered Channel that never blocks on write. 
- * If full, it overwrites the oldest data (FIFO drop).
+ * @brief Bounded lossy channel: keeps the latest `capacity` elements.
+ *
+ * A write never blocks, from a task or an ISR. When the ring is full the oldest
+ * element is replaced in the same critical section that stores the new one, and
+ * the drop is counted, so a reader can report how much it missed. Readers block
+ * on a task notification and ALT readers are woken like on any other channel.
+ *
+ * The ring is updated inside a critical section, so keep T small (a sample, a
+ * log record), as for any interrupt-fed channel.
  */
 template <typename T>
-class OverwritingChannel : public BufferedChannel<T> {
+class OverwritingChannel final : public BaseAltChan<T> {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "OverwritingChannel: elements are copied inside critical sections (and from ISRs); T must be trivially copyable");
+
+private:
+    T* ring;
+    size_t capacity;
+    size_t head = 0;               // oldest element
+    size_t count = 0;
+    volatile uint32_t drops = 0;
+
+    // A reader blocked in input()/inputBatch(), notified once reader_min elements are held
+    TaskHandle_t waiting_reader = nullptr;
+    size_t reader_min = 1;
+
+    AltScheduler* alt_reader = nullptr;
+    EventBits_t   read_bit = 0;
+
+    OverwritingInputGuard<T>  res_in_guard;
+    OverwritingOutputGuard<T> res_out_guard;
+
+    T ext_item;
+
+    // --- Ring, called inside a critical section ---
+    void push(const T& value) {
+        size_t tail = (head + count) % capacity;
+        if (count == capacity) {
+            head = (head + 1) % capacity;   // tail == head: the oldest is overwritten
+            drops = drops + 1;
+        } else {
+            count++;
+        }
+        ring[tail] = value;
+    }
+
+    bool pop(T* dest) {
+        if (count == 0) return false;
+        *dest = ring[head];
+        head = (head + 1) % capacity;
+        count--;
+        return true;
+    }
+
+    // Who to wake after a push; called inside the critical section.
+    TaskHandle_t takeReadyReader() {
+        if (waiting_reader == nullptr || count < reader_min) return nullptr;
+        TaskHandle_t t = waiting_reader;
+        waiting_reader = nullptr;
+        return t;
+    }
+
+    // Waits (with the wait bounded by timeout) until at least min elements are held.
+    bool waitFor(size_t min, TickType_t timeout) {
+        TimeOut_t start;
+        vTaskSetTimeOutState(&start);
+        while (true) {
+            xTaskNotifyStateClear(NULL);
+            taskENTER_CRITICAL();
+            bool ready = count >= min;
+            if (!ready) {
+                waiting_reader = xTaskGetCurrentTaskHandle();
+                reader_min = min;
+            }
+            taskEXIT_CRITICAL();
+            if (ready) return true;
+
+            if (timeout == 0 || xTaskCheckForTimeOut(&start, &timeout) == pdTRUE) {
+                taskENTER_CRITICAL();
+                bool committed = (waiting_reader != xTaskGetCurrentTaskHandle());
+                waiting_reader = nullptr;
+                ready = count >= min;
+                taskEXIT_CRITICAL();
+                // A writer took us off the slot and its notification is on its way:
+                // take it, or the next notification wait would return early
+                if (committed) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                return ready;
+            }
+            ulTaskNotifyTake(pdTRUE, timeout);
+        }
+    }
+
 public:
-    // Constructor
-    OverwritingChannel(size_t capacity) : BufferedChannel<T>(capacity) {}
+    /**
+     * @param capacity Number of elements kept.
+     * @param storage  Statically allocated ring of capacity elements.
+     */
+    OverwritingChannel(size_t capacity, T* storage)
+        : ring(storage), capacity(capacity), res_in_guard(this), res_out_guard(this), ext_item()
+    {
+        configASSERT(capacity > 0 && storage != nullptr);
+    }
+
+    ~OverwritingChannel() override = default;
 
     /**
-     * @brief Overrides the core output contract to implement overwrite logic.
-     * Never blocks (zero wait time).
+     * @brief Elements overwritten before a reader got them, since start-up.
      */
-    virtual void output(const T* const source) override {
-        // Try to send immediately (0 ticks wait)
-        if (xQueueSend(this->getQueueHandle(), source, 0) != pdPASS) {
-            
-            // Queue is full. Initiate overwrite sequence.
-            T dummy;
-            
-            // 1. Remove oldest item (non-blocking, zero wait).
-            // This frees one slot in the queue. We don't care about the content.
-            xQueueReceive(this->getQueueHandle(), &dummy, 0);
-            
-            // 2. Send new item (non-blocking, zero wait).
-            // This must succeed because we just freed a slot, unless another
-            // task raced to send, which is handled gracefully by the inner queue logic.
-            // Since this is CSP, we assume a safe write operation after the drop.
-            xQueueSend(this->getQueueHandle(), source, 0);
+    uint32_t dropped() const { return drops; }
+
+    // --- Writers: never block ---
+    void output(const T* const source) override {
+        taskENTER_CRITICAL();
+        push(*source);
+        TaskHandle_t reader = takeReadyReader();
+        AltScheduler* alt = alt_reader;
+        taskEXIT_CRITICAL();
+
+        if (reader != nullptr) xTaskNotifyGive(reader);
+        if (alt != nullptr) alt->wakeUp(read_bit);
+    }
+
+    bool outputFor(const T* const source, TickType_t) override {
+        output(source);
+        return true;
+    }
+
+    void outputBatch(const T* items, size_t n) {
+        taskENTER_CRITICAL();
+        for (size_t i = 0; i < n; i++) push(items[i]);
+        TaskHandle_t reader = takeReadyReader();
+        AltScheduler* alt = alt_reader;
+        taskEXIT_CRITICAL();
+
+        if (reader != nullptr) xTaskNotifyGive(reader);
+        if (alt != nullptr) alt->wakeUp(read_bit);
+    }
+
+    bool putFromISR(const T& data) override {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        push(data);
+        TaskHandle_t reader = takeReadyReader();
+        AltScheduler* alt = alt_reader;
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+
+        if (reader != nullptr) vTaskNotifyGiveFromISR(reader, &xHigherPriorityTaskWoken);
+        if (alt != nullptr) alt->wakeUp(read_bit);
+
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+        return true;
+    }
+
+    // --- Readers ---
+    void input(T* const dest) override {
+        inputFor(dest, portMAX_DELAY);
+    }
+
+    bool inputFor(T* const dest, TickType_t timeout) override {
+        while (true) {
+            taskENTER_CRITICAL();
+            bool got = pop(dest);
+            taskEXIT_CRITICAL();
+            if (got) return true;
+            // Another reader (an ALT on this end) may have emptied it again: retry
+            if (!waitFor(1, timeout)) return false;
         }
     }
 
-    // NOTE: Removed the virtual bool output_with_timeout(...) override.
-    // By providing only 'void output', we fulfill the minimum non-timed contract.
-    // If the base class (BaseChan) requires output_with_timeout, the implementation
-    // provided by BufferedChannel (or a simple pass-through to output) should suffice.
-    // By excluding the explicit override here, we eliminate the explicit mention of 'timeout'.
+    size_t drain(T* dest, size_t max_count) {
+        size_t got = 0;
+        taskENTER_CRITICAL();
+        while (got < max_count && pop(&dest[got])) got++;
+        taskEXIT_CRITICAL();
+        return got;
+    }
+
+    size_t inputBatch(T* dest, size_t max_count, size_t min_count) {
+        configASSERT(min_count <= max_count && min_count <= capacity);
+        if (min_count > 0) waitFor(min_count, portMAX_DELAY);
+        return drain(dest, max_count);
+    }
+
+    // A writer never waits here, so the element is taken out of the ring up front;
+    // otherwise an overwrite could replace it while it is being processed.
+    const T* beginExtInput() override {
+        input(&ext_item);
+        return &ext_item;
+    }
+    void endExtInput() override {}
+
+    bool pending() override {
+        taskENTER_CRITICAL();
+        bool has_data = count > 0;
+        taskEXIT_CRITICAL();
+        return has_data;
+    }
+
+    Guard* getInputGuard(T& dest) override {
+        res_in_guard.setTarget(&dest);
+        return &res_in_guard;
+    }
+
+    Guard* getOutputGuard(const T& source) override {
+        res_out_guard.setTarget(&source);
+        return &res_out_guard;
+    }
+
+    void registerInputAlt(AltScheduler* alt, EventBits_t b) {
+        taskENTER_CRITICAL(); alt_reader = alt; read_bit = b; taskEXIT_CRITICAL();
+    }
+    void unregisterInputAlt() {
+        taskENTER_CRITICAL(); alt_reader = nullptr; taskEXIT_CRITICAL();
+    }
+};
+
+template <typename T>
+class OverwritingInputGuard final : public Guard {
+private:
+    OverwritingChannel<T>* channel;
+    T* dest_ptr = nullptr;
+public:
+    OverwritingInputGuard(OverwritingChannel<T>* chan) : channel(chan) {}
+    void setTarget(T* dest) { dest_ptr = dest; }
+
+    bool enable(AltScheduler* alt, EventBits_t bit) override {
+        channel->registerInputAlt(alt, bit);
+        return channel->pending();
+    }
+    bool disable() override {
+        channel->unregisterInputAlt();
+        return channel->pending();
+    }
+    void activate() override {
+        channel->drain(dest_ptr, 1);
+    }
+};
+
+// Writing never blocks, so the output guard is always ready.
+template <typename T>
+class OverwritingOutputGuard final : public Guard {
+private:
+    OverwritingChannel<T>* channel;
+    const T* source_ptr = nullptr;
+public:
+    OverwritingOutputGuard(OverwritingChannel<T>* chan) : channel(chan) {}
+    void setTarget(const T* source) { source_ptr = source; }
+
+    bool enable(AltScheduler*, EventBits_t) override { return true; }
+    bool disable() override { return true; }
+    void activate() override { channel->output(source_ptr); }
 };
 
 } // namespace csp::internal
 
-#endif // CSP4CMSIS_OVERWRITING_CHANNEL_H
\ No newline at end of file
+#endif // CSP4CMSIS_OVERWRITING_CHANNEL_H
@@ -0,0 +1,46 @@
+// --- payload.h ---
+#ifndef CSP4CMSIS_PAYLOAD_H
+#define CSP4CMSIS_PAYLOAD_H
+
+#include <type_traits>
+#include <utility>
+
+namespace csp::internal {
+
+    /**
+     * @brief How a rendezvous hands one value from the writer's object to the reader's.
+     *
+     * The sync base and its guards are type-agnostic, so each channel gives them the
+     * ops of its T: an assignment compiled for T rather than a memcpy of a run-time
+     * size. A small trivially copyable T becomes a register copy, a T that owns
+     * resources is moved when the writer passed an rvalue, and a T with its own
+     * assignment (a fixed-capacity frame that copies only `length` bytes, say) is
+     * honoured as written.
+     */
+    struct PayloadOps {
+        void (*copy)(void* dest, const void* src);
+        void (*move)(void* dest, void* src);
+    };
+
+    template <typename T>
+    struct Payload {
+        static_assert(std::is_copy_assignable<T>::value,
+                      "Channel payload must be copy-assignable (ALT output guards copy from a const source)");
+
+        static void copy(void* dest, const void* src) {
+            *static_cast<T*>(dest) = *static_cast<const T*>(src);
+        }
+
+        static void move(void* dest, void* src) {
+            *static_cast<T*>(dest) = std::move(*static_cast<T*>(src));
+        }
+
+        static constexpr PayloadOps ops = { &Payload::copy, &Payload::move };
+    };
+
+    template <typename T>
+    constexpr PayloadOps Payload<T>::ops;
+
+} // namespace csp::internal
+
+#endif // CSP4CMSIS_PAYLOAD_H
@@ -0,0 +1,228 @@
+// --- pipeline.h ---
+#ifndef CSP4CMSIS_PIPELINE_H
+#define CSP4CMSIS_PIPELINE_H
+
+#include "process.h"
+#include "public_channel.h"
+#include <stddef.h>
+#include <tuple>
+#include <type_traits>
+#include <cstdio>
+
+namespace csp {
+
+/**
+ * Compile-time fusion of linear pipelines.
+ *
+ * A stage is a per-message transform, written as a class with one call operator:
+ *     bool operator()(const In& in, Out& out);   // true when out was produced
+ *     void operator()(const In& in);             // sink, ends the chain
+ * and optionally `bool start()`, run once before the first message (false stops
+ * the pipeline).
+ *
+ *     static auto pFront = Fuse(trigger_in, gyro_stage, shake_stage, result_chan.writer());
+ *     Run(InParallel(pFront, pUI), ExecutionMode::StaticNetwork);
+ *
+ * Fuse() returns one CSProcess: it reads the input end, hands each value to the
+ * stages as plain calls on its own stack, and writes what the last stage produces
+ * to the output end (if the chain does not end in a sink). The input is an
+ * extended rendezvous, so the first stage works on the writer's data in place and
+ * the writer is released once the value has been through the chain. Stage types
+ * must match end to end; this is checked at compile time.
+ *
+ * The first stage may also declare `static constexpr uint32_t stall_ms` and
+ * `bool stalled()`: the input is then read with read_for(), and stalled() runs
+ * whenever nothing arrives for stall_ms (false stops the pipeline). The timeout
+ * is part of the wait itself, so the watchdog adds nothing per message.
+ *
+ * A stage that blocks or ALTs declares `static constexpr bool blocking = true;`
+ * and is rejected by Fuse. Give it its own Fuse() (or an ordinary CSProcess) and
+ * connect it with a real channel; that is where the chain falls back to channels.
+ */
+
+namespace internal {
+
+    template <typename F> struct StageSignature;
+
+    template <typename S, typename In, typename Out>
+    struct StageSignature<bool (S::*)(const In&, Out&)> {
+        using input_type = In;
+        using output_type = Out;
+        static constexpr bool sink = false;
+    };
+
+    template <typename S, typename In>
+    struct StageSignature<void (S::*)(const In&)> {
+        using input_type = In;
+        using output_type = void;
+        static constexpr bool sink = true;
+    };
+
+    template <typename S>
+    using StageTraits = StageSignature<decltype(&S::operator())>;
+
+    template <typename S, typename = void>
+    struct StageBlocks { static constexpr bool value = false; };
+
+    template <typename S>
+    struct StageBlocks<S, decltype(void(S::blocking))> { static constexpr bool value = S::blocking; };
+
+    template <typename S, typename = void>
+    struct StageHasStart : std::false_type {};
+
+    template <typename S>
+    struct StageHasStart<S, decltype(void(std::declval<S&>().start()))> : std::true_type {};
+
+    template <typename S, typename = void>
+    struct StageWatchdog : std::false_type {};
+
+    template <typename S>
+    struct StageWatchdog<S, decltype(void(S::stall_ms), void(std::declval<S&>().stalled()))>
+        : std::true_type {};
+
+    template <typename E> struct IsChanout : std::false_type {};
+    template <typename T, typename C> struct IsChanout<Chanout<T, C>> : std::true_type {};
+
+    template <typename... Ss> struct AnyIsrFed : std::false_type {};
+    template <typename S, typename... Ss>
+    struct AnyIsrFed<S, Ss...>
+        : std::integral_constant<bool, DeclaredIsrFed<S>::value || AnyIsrFed<Ss...>::value> {};
+
+    // Stages are held by reference (they are static, like processes); the output end by value.
+    template <typename E>
+    using FusedElement = typename std::conditional<IsChanout<E>::value, E, E&>::type;
+
+} // namespace internal
+
+template <size_t StackWords, typename InEnd, typename... Elements>
+class FusedPipeline : public CSProcessWithStack<StackWords> {
+private:
+    using In = typename InEnd::value_type;
+    using Types = std::tuple<Elements...>;
+
+    static constexpr size_t num_elements = sizeof...(Elements);
+    static constexpr bool has_output =
+        internal::IsChanout<std::tuple_element_t<num_elements - 1, Types>>::value;
+    static constexpr size_t num_stages = has_output ? num_elements - 1 : num_elements;
+
+    static_assert(num_stages > 0, "Fuse: needs at least one stage");
+
+    template <size_t I>
+    using Stage = std::tuple_element_t<I, Types>;
+
+    // Value type flowing into element I (I == num_stages is the output end).
+    template <size_t I, bool = (I == 0)>
+    struct InputOf { using type = In; };
+    template <size_t I>
+    struct InputOf<I, false> { using type = typename internal::StageTraits<Stage<I - 1>>::output_type; };
+
+    template <size_t I>
+    static constexpr bool check() {
+        static_assert(!internal::IsChanout<Stage<I>>::value,
+                      "Fuse: only the last argument may be an output channel end");
+        static_assert(!internal::StageBlocks<Stage<I>>::value,
+                      "Fuse: stage blocks or ALTs; run it as its own process over a channel");
+        static_assert(std::is_same<typename internal::StageTraits<Stage<I>>::input_type,
+                                   typename InputOf<I>::type>::value,
+                      "Fuse: stage input type does not match the previous stage's output");
+        static_assert(!internal::StageTraits<Stage<I>>::sink || I + 1 == num_elements,
+                      "Fuse: a sink stage must end the chain");
+        return true;
+    }
+
+    template <size_t... I>
+    static constexpr bool check_all(std::index_sequence<I...>) {
+        const bool ok[] = { check<I>()... };
+        return ok[0];
+    }
+
+    static_assert(check_all(std::make_index_sequence<num_stages>{}), "");
+
+    template <bool HasOutput = has_output, bool = true>
+    struct OutputMatches { static constexpr bool value = true; };
+    template <bool Dummy>
+    struct OutputMatches<true, Dummy> {
+        static constexpr bool value =
+            std::is_same<typename InputOf<num_stages>::type, typename Stage<num_stages>::value_type>::value;
+    };
+
+    static_assert(OutputMatches<>::value, "Fuse: output channel type does not match the last stage's output");
+
+    InEnd in;
+    std::tuple<internal::FusedElement<Elements>...> elements;
+
+    template <size_t I = 0>
+    bool start_all() {
+        if constexpr (I < num_stages) {
+            if constexpr (internal::StageHasStart<Stage<I>>::value) {
+                if (!std::get<I>(elements).start()) return false;
+            }
+            return start_all<I + 1>();
+        } else {
+            return true;
+        }
+    }
+
+    // Hands v to element I and, if it produces something, on to I + 1.
+    template <size_t I, typename V>
+    void feed(const V& v) {
+        if constexpr (I == num_stages) {
+            std::get<I>(elements) << v;
+        } else if constexpr (internal::StageTraits<Stage<I>>::sink) {
+            std::get<I>(elements)(v);
+        } else {
+            typename internal::StageTraits<Stage<I>>::output_type out;
+            if (std::get<I>(elements)(v, out)) {
+                feed<I + 1>(out);
+            }
+        }
+    }
+
+public:
+    // A stage fed from an interrupt makes the whole fused task ISR-fed.
+    static constexpr bool isr_fed = internal::AnyIsrFed<Elements...>::value;
+
+    FusedPipeline(InEnd input, internal::FusedElement<Elements>... e)
+        : in(input), elements(e...) {}
+
+    const char* name() const override { return "csp_fused"; }
+
+    void run() override {
+        if (!start_all()) {
+            printf("CSP ERROR: fused pipeline stage failed to start.\r\n");
+            return;
+        }
+
+        if constexpr (internal::StageWatchdog<Stage<0>>::value) {
+            const Time stall_timeout = Milliseconds(Stage<0>::stall_ms);
+            In item;
+            while (true) {
+                if (in.read_for(item, stall_timeout)) {
+                    feed<0>(item);
+                } else if (!std::get<0>(elements).stalled()) {
+                    printf("CSP ERROR: fused pipeline input stalled.\r\n");
+                    return;
+                }
+            }
+        } else {
+            while (true) {
+                in.extRead([this](const In& item) { feed<0>(item); });
+            }
+        }
+    }
+};
+
+/**
+ * @brief Fuses stages (and an optional trailing output end) into one process.
+ * Fuse<Words>(...) sets the stack depth of the resulting task.
+ */
+template <size_t StackWords = CSP_DEFAULT_STACK_WORDS, typename In, typename InChan, typename... Args>
+FusedPipeline<StackWords, Chanin<In, InChan>, typename std::decay<Args>::type...>
+Fuse(Chanin<In, InChan> in, Args&&... args) {
+    return FusedPipeline<StackWords, Chanin<In, InChan>, typename std::decay<Args>::type...>(
+        in, std::forward<Args>(args)...);
+}
+
+} // namespace csp
+
+#endif // CSP4CMSIS_PIPELINE_H
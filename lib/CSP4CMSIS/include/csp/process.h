@@ -3,6 +3,18 @@
 #define CSP4CMSIS_PROCESS_H
 
 #include <stddef.h> // For size_t, NULL definition
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Stack depth (in words) of a spawned process that does not declare its own.
+#ifndef CSP_DEFAULT_STACK_WORDS
+#define CSP_DEFAULT_STACK_WORDS 256
+#endif
+
+// Priority of a spawned process that does not declare its own.
+#ifndef CSP_DEFAULT_PROCESS_PRIORITY
+#define CSP_DEFAULT_PROCESS_PRIORITY (tskIDLE_PRIORITY + 2)
+#endif
 
 extern "C" {
     void ThreadFuncWrapper(void* pvParameters);
@@ -12,6 +24,7 @@ namespace csp {
     // Forward declarations of core internal classes
     namespace internal {
         class Kernel;
+        class TaskPool;
     }
 
     // =============================================================
@@ -41,6 +54,62 @@ namespace csp {
     private:
         // The FreeRTOS wrapper function needs to access the protected run() method.
         friend void ::ThreadFuncWrapper(void* pvParameters);
+        friend class internal::TaskPool;
+    };
+
+    /**
+     * @brief CSProcess that declares the stack depth (in words) and priority of
+     * the task InParallel/Run create for it.
+     * e.g. class UI : public CSProcessWithStack<512> { ... };
+     */
+    template <size_t StackWords, UBaseType_t Priority = CSP_DEFAULT_PROCESS_PRIORITY>
+    class CSProcessWithStack : public CSProcess {
+    public:
+        static_assert(StackWords >= configMINIMAL_STACK_SIZE,
+                      "CSProcessWithStack: stack is smaller than configMINIMAL_STACK_SIZE");
+
+        static constexpr size_t stack_words = StackWords;
+        static constexpr UBaseType_t priority = Priority;
+    };
+
+    namespace internal {
+        template <typename P, typename = void>
+        struct DeclaredStackWords { static constexpr size_t value = CSP_DEFAULT_STACK_WORDS; };
+
+        template <typename P>
+        struct DeclaredStackWords<P, decltype(void(P::stack_words))> {
+            static constexpr size_t value = P::stack_words;
+        };
+
+        template <typename P, typename = void>
+        struct DeclaredPriority { static constexpr UBaseType_t value = CSP_DEFAULT_PROCESS_PRIORITY; };
+
+        template <typename P>
+        struct DeclaredPriority<P, decltype(void(P::priority))> {
+            static constexpr UBaseType_t value = P::priority;
+        };
+
+        template <typename P, typename = void>
+        struct DeclaredIsrFed { static constexpr bool value = false; };
+
+        template <typename P>
+        struct DeclaredIsrFed<P, decltype(void(P::isr_fed))> {
+            static constexpr bool value = P::isr_fed;
+        };
+    } // namespace internal
+
+    /**
+     * @brief Task parameters used when a process of type P is spawned.
+     * Taken from CSProcessWithStack when P derives from it, otherwise the defaults above.
+     * A process woken by an interrupt declares `static constexpr bool isr_fed = true;`
+     * and InParallel then requires it to outrank every non-ISR-fed process.
+     * Specialise for process types that cannot change their base class.
+     */
+    template <typename P>
+    struct ProcessTraits {
+        static constexpr size_t stack_words = internal::DeclaredStackWords<P>::value;
+        static constexpr UBaseType_t priority = internal::DeclaredPriority<P>::value;
+        static constexpr bool isr_fed = internal::DeclaredIsrFed<P>::value;
     };
 
 } // namespace csp
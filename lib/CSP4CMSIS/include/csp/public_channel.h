@@ -4,48 +4,93 @@
 #include "rendezvous_channel.h"
 #include "buffered_channel.h"
 #include "overwriting_channel.h"
+#include <type_traits>
 
 namespace csp {
 
-// Forward declarations
-template <typename T> class Chanin;
-template <typename T> class Chanout;
-
 /**
  * @brief Pipe Operators for Alternative Syntax.
  * These create a ChannelBinding (defined in alt_channel_sync.h)
  * using the unified getGuard() interface.
  */
-template <typename T>
-ChannelBinding<T, Chanin<T>> operator|(Chanin<T>& chan, T& dest) {
-    return ChannelBinding<T, Chanin<T>>(chan, dest);
+template <typename T, typename C>
+ChannelBinding<T, Chanin<T, C>> operator|(Chanin<T, C>& chan, T& dest) {
+    return ChannelBinding<T, Chanin<T, C>>(chan, dest);
 }
 
-template <typename T>
-ChannelBinding<const T, Chanout<T>> operator|(Chanout<T>& chan, const T& source) {
-    return ChannelBinding<const T, Chanout<T>>(chan, source);
+template <typename T, typename C>
+ChannelBinding<const T, Chanout<T, C>> operator|(Chanout<T, C>& chan, const T& source) {
+    return ChannelBinding<const T, Chanout<T, C>>(chan, source);
+}
+
+// Batch read guard (buffered channels only): in | batch(window, n, min)
+template <typename T, typename C>
+ChannelBinding<const Batch<T>, Chanin<T, C>> operator|(Chanin<T, C>& chan, const Batch<T>& b) {
+    return ChannelBinding<const Batch<T>, Chanin<T, C>>(chan, b);
 }
 
 // =============================================================
 // Channel End Wrappers (Chanout / Chanin)
 // =============================================================
 
-template <typename T>
+/**
+ * Ends returned by the channel containers are typed on the concrete, final
+ * channel class, so <<, >> and putFromISR compile to direct (inlinable) calls.
+ * They convert implicitly to the type-erased Chanin<T>/Chanout<T>, which is what
+ * a process stores when it does not care which kind of channel it is given.
+ * Guards are type-erased either way, so ALTs over mixed channel kinds work with both.
+ */
+template <typename T, typename Chan>
 class Chanout {
 private:
-    internal::BaseAltChan<T>* internal_ptr;
+    Chan* internal_ptr;
+
+    template <typename U, typename C> friend class Chanout;
+
 public:
-    Chanout(internal::BaseAltChan<T>* ptr) : internal_ptr(ptr) {}
+    using value_type = T;
+    using channel_type = Chan;
+
+    Chanout(Chan* ptr) : internal_ptr(ptr) {}
+
+    // Statically typed end -> type-erased (or any base) end.
+    template <typename Other,
+              typename = typename std::enable_if<std::is_convertible<Other*, Chan*>::value>::type>
+    Chanout(const Chanout<T, Other>& other) : internal_ptr(other.internal_ptr) {}
     
     // Blocking write
     void operator<<(const T& data) { internal_ptr->output(&data); }
     void write(const T& data) { internal_ptr->output(&data); }
+
+    // Blocking write of an rvalue: the reader's object is moved into where the channel allows
+    void operator<<(T&& data) { internal_ptr->outputMove(&data); }
+    void write(T&& data) { internal_ptr->outputMove(&data); }
+
+    /**
+     * @brief Write that gives up after timeout; false if nothing was sent.
+     * On a rendezvous channel, try_write() succeeds only if the reader is already
+     * blocked in a read (a reader in an ALT has not committed yet).
+     */
+    bool write_for(const T& data, Time timeout) { return internal_ptr->outputFor(&data, timeout.to_ticks()); }
+    bool try_write(const T& data) { return internal_ptr->outputFor(&data, 0); }
+
+    /**
+     * @brief Batch write (buffered channels): returns once all count items are
+     * queued, blocking only while the channel is full. The reader is woken once
+     * per batch, not once per item.
+     */
+    void write(const T* items, size_t count) { internal_ptr->outputBatch(items, count); }
+
+    template <size_t N>
+    void write(const T (&items)[N]) { internal_ptr->outputBatch(items, N); }
     
     /**
      * @brief Non-blocking write from an Interrupt Service Routine.
      * @return true if data was delivered or buffered, false otherwise.
      */
     bool putFromISR(const T& data) { 
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "putFromISR: an ISR can only send trivially copyable types");
         return internal_ptr->putFromISR(data); 
     }
     
@@ -57,16 +102,65 @@ public:
     }
 };
 
-template <typename T>
+template <typename T, typename Chan>
 class Chanin {
 private:
-    internal::BaseAltChan<T>* internal_ptr;
+    Chan* internal_ptr;
+
+    template <typename U, typename C> friend class Chanin;
+
 public:
-    Chanin(internal::BaseAltChan<T>* ptr) : internal_ptr(ptr) {}
+    using value_type = T;
+    using channel_type = Chan;
+
+    Chanin(Chan* ptr) : internal_ptr(ptr) {}
+
+    // Statically typed end -> type-erased (or any base) end.
+    template <typename Other,
+              typename = typename std::enable_if<std::is_convertible<Other*, Chan*>::value>::type>
+    Chanin(const Chanin<T, Other>& other) : internal_ptr(other.internal_ptr) {}
     
     // Blocking read
     void operator>>(T& dest) { internal_ptr->input(&dest); }
     void read(T& dest) { internal_ptr->input(&dest); }
+
+    /**
+     * @brief Read that gives up after timeout; false (and dest untouched) if nothing
+     * arrived. No Alternative, event group or timer is involved.
+     */
+    bool read_for(T& dest, Time timeout) { return internal_ptr->inputFor(&dest, timeout.to_ticks()); }
+    bool try_read(T& dest) { return internal_ptr->inputFor(&dest, 0); }
+
+    /**
+     * @brief Batch read (buffered channels): blocks until at least min_count items
+     * are available, then takes up to max_count in one go.
+     * @return The number of items read.
+     */
+    size_t read(T* dest, size_t max_count, size_t min_count) {
+        return internal_ptr->inputBatch(dest, max_count, min_count);
+    }
+
+    template <size_t N>
+    size_t read(T (&dest)[N], size_t min_count = N) {
+        return internal_ptr->inputBatch(dest, N, min_count);
+    }
+
+    /**
+     * @brief Lossy channels: elements overwritten before they were read, since start-up.
+     */
+    uint32_t dropped() const { return internal_ptr->dropped(); }
+
+    /**
+     * @brief Extended rendezvous: runs process(const T&) on the writer's data
+     * in place and only then releases the writer. Buffered channels run it on
+     * their own copy of the element (one copy, as read()).
+     */
+    template <typename F>
+    void extRead(F&& process) {
+        const T* data = internal_ptr->beginExtInput();
+        process(*data);
+        internal_ptr->endExtInput();
+    }
     
     /**
      * @brief Unified Guard accessor for ChannelBinding.
@@ -74,12 +168,33 @@ public:
     internal::Guard* getGuard(T& dest) { 
         return internal_ptr->getInputGuard(dest); 
     }
+
+    internal::Guard* getGuard(const Batch<T>& b) {
+        return internal_ptr->getBatchInputGuard(b.items, b.max_count, b.min_count, &b.count);
+    }
 };
 
 // =============================================================
 // Static Channel Containers
 // =============================================================
 
+/**
+ * @brief Opt-in priority inheritance for a rendezvous channel:
+ *
+ *     static One2OneChannel<Sample> samples(InheritPriority);
+ *
+ * A process blocked in a read or write lends its priority to the process last
+ * seen on the other end, if that one runs lower, until the hand-off completes or
+ * the wait times out. A low-priority partner then cannot be held off by
+ * medium-priority work while a high-priority process waits for it.
+ * maxPriorityBoost() is the largest boost lent so far. Partners in an ALT are not
+ * waiting and lend nothing; an ISR writer has no priority to raise.
+ */
+struct InheritPriorityTag {
+    explicit constexpr InheritPriorityTag() = default;
+};
+constexpr InheritPriorityTag InheritPriority{};
+
 /**
  * @brief Zero-capacity Rendezvous Channel.
  */
@@ -88,10 +203,16 @@ class One2OneChannel {
 private:
     internal::RendezvousChannel<T> internal_chan;
 public:
-    One2OneChannel() = default;
+    using Writer = Chanout<T, internal::RendezvousChannel<T>>;
+    using Reader = Chanin<T, internal::RendezvousChannel<T>>;
+
+    constexpr One2OneChannel() = default;
+    constexpr explicit One2OneChannel(InheritPriorityTag) : internal_chan(true) {}
+
+    UBaseType_t maxPriorityBoost() const { return internal_chan.maxPriorityBoost(); }
     
-    Chanout<T> writer() { return Chanout<T>(&internal_chan); }
-    Chanin<T> reader() { return Chanin<T>(&internal_chan); }
+    Writer writer() { return Writer(&internal_chan); }
+    Reader reader() { return Reader(&internal_chan); }
 };
 
 template <typename T>
@@ -103,18 +224,43 @@ using Channel = One2OneChannel<T>;
 template <typename T, size_t SIZE>
 class BufferedOne2OneChannel {
 private:
-    internal::BufferedChannel<T> internal_chan;
+    static_assert(SIZE > 0, "BufferedOne2OneChannel needs a capacity of at least one");
+    alignas(T) uint8_t storage[SIZE * sizeof(T)];
+    internal::FifoChannel<T> internal_chan;
 public:
-    BufferedOne2OneChannel() : internal_chan(SIZE) {}
+    using Writer = Chanout<T, internal::FifoChannel<T>>;
+    using Reader = Chanin<T, internal::FifoChannel<T>>;
+
+    BufferedOne2OneChannel() : internal_chan(SIZE, storage) {}
     
-    Chanout<T> writer() { return Chanout<T>(&internal_chan); }
-    Chanin<T> reader() { return Chanin<T>(&internal_chan); }
+    Writer writer() { return Writer(&internal_chan); }
+    Reader reader() { return Reader(&internal_chan); }
 };
 
-// --- Standard CSP Aliases ---
-template <typename T> 
-using Any2OneChannel = One2OneChannel<T>;
+/**
+ * @brief Lossy channel keeping the latest SIZE elements. Writes never block (from
+ * a task or an ISR); when full, the oldest element is replaced and counted in
+ * dropped(). For taps that must never slow the stream they hang off.
+ */
+template <typename T, size_t SIZE>
+class LossyOne2OneChannel {
+private:
+    static_assert(SIZE > 0, "LossyOne2OneChannel needs a capacity of at least one");
+    T storage[SIZE];
+    internal::OverwritingChannel<T> internal_chan;
+public:
+    using Writer = Chanout<T, internal::OverwritingChannel<T>>;
+    using Reader = Chanin<T, internal::OverwritingChannel<T>>;
+
+    LossyOne2OneChannel() : storage(), internal_chan(SIZE, storage) {}
 
+    Writer writer() { return Writer(&internal_chan); }
+    Reader reader() { return Reader(&internal_chan); }
+};
+
+// --- Standard CSP Aliases ---
+// The FreeRTOS queue already serialises concurrent writers. The rendezvous
+// Any2One/One2Any/Any2Any channels are in shared_channel.h.
 template <typename T, size_t S> 
 using BufferedAny2OneChannel = BufferedOne2OneChannel<T, S>;
 
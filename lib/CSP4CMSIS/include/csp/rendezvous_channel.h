@@ -5,22 +5,27 @@
 #include "alt_channel_sync.h"   
 #include "FreeRTOS.h"
 #include "task.h"               
+#include "payload.h"
 #include <cstring>    
 #include <cstdio>  
+#include <type_traits>
 
 namespace csp::internal {
 
 template <typename T>
-class RendezvousChannel : public BaseAltChan<T> {
+class RendezvousChannel final : public BaseAltChan<T> {
 private:
     AltChanSyncBase sync_base;
     internal::ChanInGuard  res_in_guard;
     internal::ChanOutGuard res_out_guard; 
+    internal::ChanInPendingGuard res_pending_guard;
 
 public:
-    RendezvousChannel() 
-        : res_in_guard(&sync_base, nullptr, sizeof(T)),
-          res_out_guard(&sync_base, nullptr, sizeof(T)) {}
+    constexpr explicit RendezvousChannel(bool inherit_priority = false) 
+        : sync_base(&Payload<T>::ops, inherit_priority),
+          res_in_guard(&sync_base),
+          res_out_guard(&sync_base),
+          res_pending_guard(&sync_base) {}
 
     virtual ~RendezvousChannel() override = default;
 
@@ -29,8 +34,10 @@ public:
         xTaskNotifyStateClear(NULL);
 
         if (xSemaphoreTake(sync_base.getMutex(), portMAX_DELAY) == pdTRUE) {
+            sync_base.noteEnd(false);
+
             // 1. Check if a standard sender is already waiting
-            if (sync_base.tryHandshake((void*)dest, sizeof(T), false)) {
+            if (sync_base.tryHandshake((void*)dest, false)) {
                 xSemaphoreGive(sync_base.getMutex());
                 return; 
             }
@@ -43,27 +50,82 @@ public:
 
             // 3. No partner ready yet: Register and block
             sync_base.registerWaitingTask((void*)dest, false);
+            sync_base.boostPartner(false);
             xSemaphoreGive(sync_base.getMutex());
         }
 
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 
+    // --- Timed Input: the same hand-off, with a bounded wait on the notification ---
+    virtual bool inputFor(T* const dest, TickType_t timeout) override {
+        xTaskNotifyStateClear(NULL);
+
+        if (xSemaphoreTake(sync_base.getMutex(), portMAX_DELAY) != pdTRUE) return false;
+        sync_base.noteEnd(false);
+
+        if (sync_base.tryHandshake((void*)dest, false)) {
+            xSemaphoreGive(sync_base.getMutex());
+            return true;
+        }
+        if (timeout == 0) {
+            xSemaphoreGive(sync_base.getMutex());
+            return false;
+        }
+
+        if (sync_base.getAltOutScheduler() != nullptr) {
+            sync_base.getAltOutScheduler()->wakeUp(sync_base.getAltOutBit());
+        }
+
+        sync_base.registerWaitingTask((void*)dest, false);
+        sync_base.boostPartner(false);
+        xSemaphoreGive(sync_base.getMutex());
+
+        if (ulTaskNotifyTake(pdTRUE, timeout) != 0) return true;
+        return sync_base.withdraw(false);
+    }
+
     // --- Blocking Output (Sender) ---
-    virtual void output(const T* const source) override {
+    virtual void output(const T* const source) override { send(source, false, portMAX_DELAY); }
+
+    // The writer gave an rvalue: the reader's object is move-assigned from it
+    virtual void outputMove(T* const source) override { send(source, true, portMAX_DELAY); }
+
+    virtual bool outputFor(const T* const source, TickType_t timeout) override {
+        return send(source, false, timeout);
+    }
+
+private:
+    bool send(const T* const source, bool movable, TickType_t timeout) {
         xTaskNotifyStateClear(NULL);
         // printf("[Producer] Channel %p: Entering output()\n", (void*)this);
 
         if (xSemaphoreTake(sync_base.getMutex(), portMAX_DELAY) == pdTRUE) {
-            // 1. Check for standard waiter
+            sync_base.noteEnd(true);
+
+            // 1. Check for a reader in an extended input: lend it our buffer
+            if (sync_base.isExtReaderWaiting()) {
+                sync_base.lendToExtReader(source);
+                xSemaphoreGive(sync_base.getMutex());
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                return true;
+            }
+
+            // 2. Check for standard waiter
             if (sync_base.getWaitingInTask() != nullptr) {
                 // printf("[Producer] Channel %p: Found standard blocking receiver.\r\n", (void*)this);
-                sync_base.tryHandshake((void*)const_cast<T*>(source), sizeof(T), true);
+                sync_base.tryHandshake((void*)const_cast<T*>(source), true, movable);
                 xSemaphoreGive(sync_base.getMutex());
-                return; 
+                return true; 
+            }
+
+            // A non-blocking write needs a reader that is already blocked
+            if (timeout == 0) {
+                xSemaphoreGive(sync_base.getMutex());
+                return false;
             }
 
-            // 2. Check for ALT waiter (The Critical Path)
+            // 3. Check for ALT waiter (The Critical Path)
             if (sync_base.getAltInScheduler() != nullptr) {
                 // printf("[Producer] Channel %p: FOUND ALTed receiver! Waking bit %lu\r\n", (void*)this, (unsigned long)sync_base.getAltInBit());
                 
@@ -75,13 +137,17 @@ public:
                 // printf("[Producer] Channel %p: No receiver found. Registering and blocking.\r\n", (void*)this);
             }
 
-            sync_base.registerWaitingTask((void*)const_cast<T*>(source), true);
+            sync_base.registerWaitingTask((void*)const_cast<T*>(source), true, movable);
+            sync_base.boostPartner(true);
             xSemaphoreGive(sync_base.getMutex());
         }
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (ulTaskNotifyTake(pdTRUE, timeout) != 0) return true;
         // printf("[Producer] Channel %p: Output complete.\n", (void*)this);
+        return sync_base.withdraw(true);
     }
 
+public:
+
     // --- Resident Guard Implementation ---
     virtual internal::Guard* getInputGuard(T& dest) override {
         res_in_guard.updateBuffer(&dest); 
@@ -92,6 +158,12 @@ public:
         res_out_guard.updateBuffer(const_cast<void*>(static_cast<const void*>(&source)));
         return &res_out_guard; 
     }
+
+    // Ready while a writer waits; the reader then takes the value itself
+    internal::Guard* getPendingInputGuard() { return &res_pending_guard; }
+
+    // Largest priority boost lent across this channel (priority inheritance only)
+    UBaseType_t maxPriorityBoost() const { return sync_base.maxPriorityBoost(); }
     
     virtual bool pending() override {
         bool has_partner = false;
@@ -106,17 +178,29 @@ public:
         return has_partner;
     }
     
+    // Only reachable for trivially copyable T (Chanout::putFromISR checks at compile time):
+    // an ISR must not run a copy constructor that may allocate or lock.
     virtual bool putFromISR(const T& data) override {
+        configASSERT(std::is_trivially_copyable<T>::value);
         bool success = false;
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
         // Use a critical section instead of a Mutex (ISRs cannot take Mutexes)
         UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 
-        // 1. Check if a standard blocking reader is waiting
-        if (sync_base.getWaitingInTask() != nullptr) {
+        // 1. An extended reader cannot borrow from an ISR: stage the data in the channel
+        if (sync_base.isExtReaderWaiting()) {
+            std::memcpy(isr_slot, &data, sizeof(T));
+            TaskHandle_t toWake = sync_base.getWaitingInTask();
+            sync_base.clearWaitingIn();
+            ext_from_isr = true;
+            vTaskNotifyGiveFromISR(toWake, &xHigherPriorityTaskWoken);
+            success = true;
+        }
+        // 2. Check if a standard blocking reader is waiting
+        else if (sync_base.getWaitingInTask() != nullptr) {
             // Copy data directly to reader's buffer
-            std::memcpy(sync_base.getNonAltInDataPtr(), &data, sizeof(T));
+            Payload<T>::copy(sync_base.getNonAltInDataPtr(), &data);
             
             TaskHandle_t toWake = sync_base.getWaitingInTask();
             sync_base.clearWaitingIn(); // Clear internal pointers
@@ -125,7 +209,7 @@ public:
             vTaskNotifyGiveFromISR(toWake, &xHigherPriorityTaskWoken);
             success = true;
         } 
-        // 2. Check if a reader is waiting in an ALT
+        // 3. Check if a reader is waiting in an ALT
         else if (sync_base.getAltInScheduler() != nullptr) {
             // Signal the AltScheduler (it will handle data copy during activate())
             sync_base.getAltInScheduler()->wakeUp(sync_base.getAltInBit());
@@ -139,8 +223,53 @@ public:
         return success;
     }
 
-    virtual void beginExtInput(T* const dest) override {}
-    virtual void endExtInput() override {}
+    // --- Extended Input (Receiver) ---
+    // Returns the writer's own buffer; the writer is released by endExtInput().
+    virtual const T* beginExtInput() override {
+        xTaskNotifyStateClear(NULL);
+
+        if (xSemaphoreTake(sync_base.getMutex(), portMAX_DELAY) == pdTRUE) {
+            sync_base.noteEnd(false);
+
+            // 1. A standard sender is already parked with its buffer: take it off the
+            // channel, so that it stays committed until endExtInput()
+            if (sync_base.getWaitingOutTask() != nullptr) {
+                const T* data = static_cast<const T*>(sync_base.borrowFromWriter());
+                xSemaphoreGive(sync_base.getMutex());
+                return data;
+            }
+
+            // 2. Wake an ALTed sender so that its activate() lends us its buffer
+            if (sync_base.getAltOutScheduler() != nullptr) {
+                sync_base.getAltOutScheduler()->wakeUp(sync_base.getAltOutBit());
+            }
+
+            // 3. Register and block until a sender lends us its buffer
+            ext_from_isr = false;
+            sync_base.registerExtReader();
+            sync_base.boostPartner(false);
+            xSemaphoreGive(sync_base.getMutex());
+        }
+
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (ext_from_isr) return reinterpret_cast<const T*>(isr_slot);
+        return static_cast<const T*>(sync_base.getExtDataPtr());
+    }
+
+    virtual void endExtInput() override {
+        if (xSemaphoreTake(sync_base.getMutex(), portMAX_DELAY) == pdTRUE) {
+            // An ISR sender has nothing to release
+            sync_base.releaseExtWriter();
+            ext_from_isr = false;
+            xSemaphoreGive(sync_base.getMutex());
+        }
+    }
+
+private:
+    // Staging slot for an ISR sender that meets an extended reader
+    alignas(T) unsigned char isr_slot[sizeof(T)] = {};
+    volatile bool ext_from_isr = false;
 };
 
 } // namespace csp::internal
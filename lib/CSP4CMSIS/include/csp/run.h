@@ -5,8 +5,16 @@
 #include "task.h"
 #include "semphr.h"
 #include <tuple>
-#include <vector>
+#include <type_traits>
+#include <utility>
+#include <cstdio>
 #include "csp4cmsis.h" 
+#include "task_pool.h"
+
+// Upper bound on the stack RAM one network (or one Run(process)) may reserve.
+#ifndef CSP_STACK_BUDGET_BYTES
+#define CSP_STACK_BUDGET_BYTES (32u * 1024u)
+#endif
 
 // --- 1. START CSP NAMESPACE (For Definitions) ---
 namespace csp {
@@ -34,84 +42,256 @@ extern "C" {
 // --- 3. Continue CSP Namespace (For Template Logic) ---
 namespace csp { 
 
+namespace internal {
+    /**
+     * @brief Static TCB, stack and wrapper context of one spawned process.
+     * Trivial type, so the function-local statics below are zero-initialised in
+     * .bss without guard variables.
+     */
+    template <size_t StackWords>
+    struct TaskSlot {
+        StaticTask_t tcb;
+        StackType_t stack[StackWords];
+        TaskCtx ctx;
+        TaskHandle_t handle;
+    };
+
+    template <typename P>
+    using TaskSlotFor = TaskSlot<ProcessTraits<P>::stack_words>;
+
+    template <typename... Ps> struct StackBytes;
+    template <> struct StackBytes<> { static constexpr size_t value = 0; };
+    template <typename P, typename... Ps>
+    struct StackBytes<P, Ps...> {
+        static constexpr size_t value =
+            ProcessTraits<P>::stack_words * sizeof(StackType_t) + StackBytes<Ps...>::value;
+    };
+
+    /**
+     * @brief How InParallel stores one of its arguments: a plain process by
+     * reference at its declared priority, or a Prio<N>() wrapper by value.
+     */
+    template <typename E>
+    struct NetworkEntry {
+        using process_type = E;
+        using stored_type = E&;
+        static constexpr bool explicit_priority = false;
+        static constexpr UBaseType_t priority = ProcessTraits<E>::priority;
+        static E& process(E& e) { return e; }
+    };
+
+    template <typename P>
+    TaskHandle_t spawn_static(TaskSlotFor<P>& slot, P& process, SemaphoreHandle_t sem, UBaseType_t priority) {
+        // A live task still owns this slot: the same network (or the same process type
+        // via Run) was launched twice.
+        configASSERT(slot.handle == NULL);
+
+        slot.ctx = TaskCtx{ &process, sem };
+        slot.handle = xTaskCreateStatic(
+            (TaskFunction_t)ThreadFuncWrapper,
+            process.name(),
+            ProcessTraits<P>::stack_words,
+            &slot.ctx,
+            priority,
+            slot.stack,
+            &slot.tcb
+        );
+        return slot.handle;
+    }
+} // namespace internal
+
+/**
+ * @brief A process with the priority it is given in a network declaration,
+ * overriding the one it declares itself. Created by Prio<N>(process).
+ */
+template <UBaseType_t Priority, typename P>
+struct Prioritised {
+    static_assert(Priority < configMAX_PRIORITIES, "Prio: priority must be below configMAX_PRIORITIES");
+    P& process;
+};
+
+/**
+ * @brief Attaches a priority to a process in a network declaration:
+ * InParallel(Prio<5>(sensor), Prio<4>(filter), ui).
+ * The first process of a network runs on the caller's task, which is raised to
+ * this priority for the duration of the run.
+ */
+template <UBaseType_t Priority, typename P>
+Prioritised<Priority, P> Prio(P& process) {
+    return Prioritised<Priority, P>{ process };
+}
+
+namespace internal {
+    template <UBaseType_t Priority, typename P>
+    struct NetworkEntry<Prioritised<Priority, P>> {
+        using process_type = P;
+        using stored_type = Prioritised<Priority, P>;
+        static constexpr bool explicit_priority = true;
+        static constexpr UBaseType_t priority = Priority;
+        static P& process(const Prioritised<Priority, P>& e) { return e.process; }
+    };
+} // namespace internal
+
 // --- Parallel Helper ---
 template <typename... Processes>
 class ParallelHelper {
 private:
-    std::tuple<Processes&...> procs;
+    std::tuple<typename internal::NetworkEntry<Processes>::stored_type...> procs;
+
+    template <std::size_t I>
+    using Entry = internal::NetworkEntry<std::tuple_element_t<I, std::tuple<Processes...>>>;
+
+    template <std::size_t I>
+    using Proc = typename Entry<I>::process_type;
+
+    // Index 0 runs on the caller's stack; only the others get a task.
+    static_assert(internal::StackBytes<typename internal::NetworkEntry<Processes>::process_type...>::value
+                      - ProcessTraits<Proc<0>>::stack_words * sizeof(StackType_t)
+                  <= CSP_STACK_BUDGET_BYTES,
+                  "InParallel: process stacks exceed CSP_STACK_BUDGET_BYTES");
+
+    /**
+     * True when every ISR-fed process (ProcessTraits<P>::isr_fed) runs strictly
+     * above every other process, so a long UI/printf burst can never delay the
+     * reader of an interrupt. first_priority is the effective priority of index 0.
+     */
+    static constexpr bool isr_fed_on_top(UBaseType_t first_priority) {
+        const UBaseType_t prio[] = { internal::NetworkEntry<Processes>::priority... };
+        const bool isr_fed[] = { ProcessTraits<typename internal::NetworkEntry<Processes>::process_type>::isr_fed... };
+
+        bool any_isr = false, any_other = false;
+        UBaseType_t lowest_isr = 0, highest_other = 0;
+        for (size_t i = 0; i < sizeof...(Processes); ++i) {
+            const UBaseType_t p = (i == 0) ? first_priority : prio[i];
+            if (isr_fed[i]) {
+                lowest_isr = any_isr ? (p < lowest_isr ? p : lowest_isr) : p;
+                any_isr = true;
+            } else {
+                highest_other = any_other ? (p > highest_other ? p : highest_other) : p;
+                any_other = true;
+            }
+        }
+        return !any_isr || !any_other || lowest_isr > highest_other;
+    }
+
+    // Checked at compile time when index 0 carries a Prio<>; otherwise it runs at
+    // the caller's priority and is checked when the network starts.
+    static_assert(!Entry<0>::explicit_priority || isr_fed_on_top(Entry<0>::priority),
+                  "InParallel: ISR-fed processes must have the highest priorities in the network");
+
+    // Storage for process I of this network shape when it does not run on a pool
+    // worker. One per (Processes..., I), so two such networks with identical process
+    // types cannot both be live (asserted in spawn_static).
+    template <std::size_t I>
+    static internal::TaskSlotFor<Proc<I>>& slot() {
+        static internal::TaskSlotFor<Proc<I>> storage;
+        return storage;
+    }
 
     // Helper to spawn a task for a specific process index
     template <std::size_t I>
-    void spawn_task(SemaphoreHandle_t sem, UBaseType_t priority) {
-        // Uses the now-defined TaskCtx
-        TaskCtx* ctx = new TaskCtx{ &std::get<I>(procs), sem };
-        
-        xTaskCreate(
-            (TaskFunction_t)ThreadFuncWrapper, 
-            std::get<I>(procs).name(),
-            256, 
-            ctx,
-            priority,
-            NULL
-        );
+    void spawn_task(SemaphoreHandle_t sem) {
+        internal::spawn_static(slot<I>(), Entry<I>::process(std::get<I>(procs)), sem, Entry<I>::priority);
     }
 
     // Recursive spawner: Spawns tasks for indices 1 to N (skipping 0)
     template <std::size_t I>
-    void spawn_others(SemaphoreHandle_t sem, UBaseType_t priority) {
+    void spawn_others(SemaphoreHandle_t sem) {
         if constexpr (I < sizeof...(Processes)) {
-            spawn_task<I>(sem, priority);
-            spawn_others<I + 1>(sem, priority);
+            spawn_task<I>(sem);
+            spawn_others<I + 1>(sem);
         }
     }
-    
-    // *** Spawns ALL processes (for non-blocking SPN launch) ***
+
+    // Forks indices I..N for a terminating network: onto an idle pool worker when the
+    // process fits its stack, otherwise onto a task of its own.
+    template <std::size_t I>
+    void fork_others(SemaphoreHandle_t sem, bool (&pooled)[sizeof...(Processes)]) {
+        if constexpr (I < sizeof...(Processes)) {
+            pooled[I] = ProcessTraits<Proc<I>>::stack_words <= CSP_TASK_POOL_STACK_WORDS
+                && internal::TaskPool::dispatch(&Entry<I>::process(std::get<I>(procs)), sem, Entry<I>::priority);
+            if (!pooled[I]) {
+                spawn_task<I>(sem);
+            }
+            fork_others<I + 1>(sem, pooled);
+        }
+    }
+
+    // Deletes the joined tasks of indices I..N so their slots can be reused. Done
+    // here rather than by the tasks themselves: a self-deleted static task stays on
+    // the idle task's termination list and its TCB must not be recycled until then.
+    // Pool workers are not deleted; they rejoined the pool before signalling.
     template <std::size_t I>
-    void spawn_all(SemaphoreHandle_t sem, UBaseType_t priority) {
+    void reap_others(const bool (&pooled)[sizeof...(Processes)]) {
         if constexpr (I < sizeof...(Processes)) {
-            spawn_task<I>(sem, priority);
-            spawn_all<I + 1>(sem, priority);
+            if (!pooled[I]) {
+                vTaskDelete(slot<I>().handle);
+                slot<I>().handle = NULL;
+            }
+            reap_others<I + 1>(pooled);
+        }
+    }
+
+    // Runs process 0 on the calling task, at its Prio<> if it has one.
+    void run_first() {
+        const UBaseType_t caller_priority = uxTaskPriorityGet(NULL);
+
+        if (Entry<0>::explicit_priority) {
+            vTaskPrioritySet(NULL, Entry<0>::priority);
+        } else if (!isr_fed_on_top(caller_priority)) {
+            printf("CSP ERROR: InParallel: ISR-fed process below a non-ISR-fed one (caller priority %u).\r\n",
+                   (unsigned)caller_priority);
+            configASSERT(pdFALSE);
+        }
+
+        Entry<0>::process(std::get<0>(procs)).run();
+
+        if (Entry<0>::explicit_priority) {
+            vTaskPrioritySet(NULL, caller_priority);
         }
     }
 
 public:
-    explicit ParallelHelper(Processes&... p) : procs(p...) {}
+    explicit ParallelHelper(typename internal::NetworkEntry<Processes>::stored_type... p) : procs(p...) {}
 
     // 1. *** Renamed/Modified: Standard Blocking Run (ExecutionMode::TerminatingNetwork) ***
-    void execute_terminating(UBaseType_t priority) {
+    void execute_terminating() {
         constexpr size_t num_procs = sizeof...(Processes);
         
         SemaphoreHandle_t done_sem = NULL;
+        StaticSemaphore_t done_sem_storage;
+        bool pooled[num_procs] = {};
         if constexpr (num_procs > 1) {
-             done_sem = xSemaphoreCreateCounting(num_procs - 1, 0);
-             spawn_others<1>(done_sem, priority);
+             done_sem = xSemaphoreCreateCountingStatic(num_procs - 1, 0, &done_sem_storage);
+             fork_others<1>(done_sem, pooled);
         }
 
         // Run the first process on the current stack
-        std::get<0>(procs).run(); 
+        run_first();
 
         if (done_sem) {
             for (size_t i = 1; i < num_procs; ++i) {
                 xSemaphoreTake(done_sem, portMAX_DELAY);
             }
+            reap_others<1>(pooled);
             vSemaphoreDelete(done_sem);
         }
     }
 
     // 2. *** MODIFIED: Non-Blocking Run (ExecutionMode::StaticNetwork) ***
-    void execute_static(UBaseType_t priority) {
+    void execute_static() {
         constexpr size_t num_procs = sizeof...(Processes);
         
         // 1. Spawn all processes *except* the first one (the intended orchestrator)
         if constexpr (num_procs > 1) {
              // Use spawn_others to launch w1, w2, w3, c1. 
              // Pass NULL for the semaphore since these tasks are perpetual and won't signal completion.
-             spawn_others<1>(NULL, priority); 
+             spawn_others<1>(NULL);
         }
 
         // 2. Run the first process (f1) on the current stack. 
         // This thread (MainApp_Task) will be BLOCKED until f1.run() returns.
-        std::get<0>(procs).run(); 
+        run_first();
         
         // 3. The current thread (MainApp_Task) unblocks here when f1 finishes.
         
@@ -122,28 +302,52 @@ public:
 
 // --- Public API Syntax ---
 
+// Arguments are processes (lvalues) or Prio<N>(process) wrappers.
 template <typename... Processes>
-ParallelHelper<Processes...> InParallel(Processes&... procs) {
-    return ParallelHelper<Processes...>(procs...);
+ParallelHelper<typename std::decay<Processes>::type...> InParallel(Processes&&... procs) {
+    return ParallelHelper<typename std::decay<Processes>::type...>(std::forward<Processes>(procs)...);
 }
 
 // 1. Overloaded Run for Terminating Networks (Original behavior, implicitly uses TerminatingNetwork mode)
 template <typename... Processes>
 void Run(ParallelHelper<Processes...> helper) {
-    helper.execute_terminating(tskIDLE_PRIORITY + 2);
+    helper.execute_terminating();
 }
 
 // 2. *** NEW Overloaded Run (The requested change) ***
 template <typename... Processes>
 void Run(ParallelHelper<Processes...> helper, ExecutionMode mode) {
     if (mode == ExecutionMode::StaticNetwork) {
-        helper.execute_static(tskIDLE_PRIORITY + 2);
+        helper.execute_static();
     } else {
         // Fallback or explicit selection of TerminatingNetwork
-        helper.execute_terminating(tskIDLE_PRIORITY + 2);
+        helper.execute_terminating();
     }
 }
 
+/**
+ * @brief Launches a single process as its own task, enforcing the Static Process Network (SPN) model.
+ * The TCB and stack (ProcessTraits<P>::stack_words) are static storage owned by the process type,
+ * so at most one process of each type can be launched this way.
+ * @param process Reference to the STATICALLY allocated process object.
+ * @param priority The FreeRTOS priority for this task.
+ */
+template <typename P>
+typename std::enable_if<std::is_base_of<CSProcess, P>::value>::type
+Run(P& process, UBaseType_t priority = ProcessTraits<P>::priority) {
+    static_assert(ProcessTraits<P>::stack_words * sizeof(StackType_t) <= CSP_STACK_BUDGET_BYTES,
+                  "Run: process stack exceeds CSP_STACK_BUDGET_BYTES");
+
+    static internal::TaskSlotFor<P> storage;
+    internal::spawn_static(storage, process, NULL, priority);
+}
+
+// Run(Prio<N>(process)): same as Run(process, N).
+template <UBaseType_t Priority, typename P>
+void Run(Prioritised<Priority, P> entry) {
+    Run(entry.process, Priority);
+}
+
 } // namespace csp
 
 #endif // CSP_WRAPPER_H
\ No newline at end of file
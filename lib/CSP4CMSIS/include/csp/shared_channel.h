@@ -0,0 +1,274 @@
+// --- shared_channel.h ---
+#ifndef CSP4CMSIS_SHARED_CHANNEL_H
+#define CSP4CMSIS_SHARED_CHANNEL_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rendezvous_channel.h"
+#include "public_channel.h"
+#include <stddef.h>
+#include <cstdio>
+
+namespace csp::internal {
+
+/**
+ * @brief Admits the tasks sharing one end of a channel one at a time, in arrival order.
+ *
+ * The rendezvous underneath keeps a single waiting slot per side, so a shared end
+ * lets exactly one task into the channel and queues the others here. Leaving hands
+ * the turn straight to the oldest waiter: nobody can overtake a queued task, and
+ * the waiter is woken with one notification once it owns the turn.
+ */
+template <size_t MaxWaiters>
+class Turnstile {
+    static_assert(MaxWaiters > 0, "Turnstile needs room for at least one waiting task");
+
+private:
+    TaskHandle_t owner;
+    TaskHandle_t queue[MaxWaiters];
+    size_t head;
+    size_t count;
+
+    // Called with interrupts masked.
+    bool remove(TaskHandle_t task) {
+        for (size_t i = 0; i < count; i++) {
+            if (queue[(head + i) % MaxWaiters] == task) {
+                for (size_t j = i; j + 1 < count; j++) {
+                    queue[(head + j) % MaxWaiters] = queue[(head + j + 1) % MaxWaiters];
+                }
+                count--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void tooManyWaiters() {
+        printf("CSP ERROR: More tasks share a channel end than it has room to queue.\r\n");
+        configASSERT(pdFALSE);
+    }
+
+public:
+    constexpr Turnstile() : owner(nullptr), queue{}, head(0), count(0) {}
+
+    /**
+     * @brief Waits for the turn. On return, timeout holds what is left of it.
+     * @return false if the turn did not come within timeout.
+     */
+    bool enter(TickType_t& timeout) {
+        TimeOut_t start;
+        vTaskSetTimeOutState(&start);
+        TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+        taskENTER_CRITICAL();
+        bool entered = (owner == nullptr);
+        bool queued = false;
+        if (entered) {
+            owner = self;
+        } else if (timeout != 0 && count < MaxWaiters) {
+            queue[(head + count) % MaxWaiters] = self;
+            count++;
+            queued = true;
+        }
+        taskEXIT_CRITICAL();
+
+        if (entered) return true;
+        if (!queued) {
+            if (timeout != 0) tooManyWaiters();
+            return false;
+        }
+
+        while (true) {
+            bool expired = xTaskCheckForTimeOut(&start, &timeout) == pdTRUE;
+            bool notified = !expired && ulTaskNotifyTake(pdTRUE, timeout) != 0;
+
+            taskENTER_CRITICAL();
+            bool mine = (owner == self);
+            if (!mine && expired) remove(self);
+            taskEXIT_CRITICAL();
+
+            if (mine) {
+                // Handed over as we timed out: the notification is on its way
+                if (!notified) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                return true;
+            }
+            if (expired) return false;
+        }
+    }
+
+    void enter() {
+        TickType_t forever = portMAX_DELAY;
+        enter(forever);
+    }
+
+    void leave() {
+        taskENTER_CRITICAL();
+        TaskHandle_t next = nullptr;
+        if (count > 0) {
+            next = queue[head];
+            head = (head + 1) % MaxWaiters;
+            count--;
+        }
+        owner = next;
+        taskEXIT_CRITICAL();
+
+        if (next != nullptr) xTaskNotifyGive(next);
+    }
+};
+
+/**
+ * @brief Rendezvous channel with either end (or both) shared by several processes.
+ *
+ * Each shared end passes through a Turnstile, so the rendezvous underneath only
+ * ever sees one writer and one reader, and every shared process completes its
+ * communication in the order it arrived. The unshared end is the plain rendezvous
+ * end, ALT included; a shared end cannot be used in an ALT, because a guard that
+ * is only enabled could not hold the turn. Interrupts write without taking a
+ * turn: putFromISR() only ever completes with a reader that is already blocked.
+ */
+template <typename T, bool SharedWriters, bool SharedReaders, size_t MaxWaiters>
+class SharedChannel final : public BaseAltChan<T> {
+private:
+    RendezvousChannel<T> chan;
+    Turnstile<MaxWaiters> writers;
+    Turnstile<MaxWaiters> readers;
+
+    static Guard* sharedEndInAlt() {
+        printf("CSP ERROR: A shared channel end cannot be used in an Alternative.\r\n");
+        configASSERT(pdFALSE);
+        return nullptr;
+    }
+
+public:
+    constexpr SharedChannel() = default;
+    ~SharedChannel() override = default;
+
+    // --- Reading end ---
+    void input(T* const dest) override {
+        if (SharedReaders) readers.enter();
+        chan.input(dest);
+        if (SharedReaders) readers.leave();
+    }
+
+    bool inputFor(T* const dest, TickType_t timeout) override {
+        if (SharedReaders && !readers.enter(timeout)) return false;
+        bool done = chan.inputFor(dest, timeout);
+        if (SharedReaders) readers.leave();
+        return done;
+    }
+
+    // The turn is held until endExtInput(), while the writer's data is borrowed
+    const T* beginExtInput() override {
+        if (SharedReaders) readers.enter();
+        return chan.beginExtInput();
+    }
+
+    void endExtInput() override {
+        chan.endExtInput();
+        if (SharedReaders) readers.leave();
+    }
+
+    Guard* getInputGuard(T& dest) override {
+        if (SharedReaders) return sharedEndInAlt();
+        return chan.getInputGuard(dest);
+    }
+
+    // --- Writing end ---
+    void output(const T* const source) override {
+        if (SharedWriters) writers.enter();
+        chan.output(source);
+        if (SharedWriters) writers.leave();
+    }
+
+    void outputMove(T* const source) override {
+        if (SharedWriters) writers.enter();
+        chan.outputMove(source);
+        if (SharedWriters) writers.leave();
+    }
+
+    bool outputFor(const T* const source, TickType_t timeout) override {
+        if (SharedWriters && !writers.enter(timeout)) return false;
+        bool done = chan.outputFor(source, timeout);
+        if (SharedWriters) writers.leave();
+        return done;
+    }
+
+    bool putFromISR(const T& data) override { return chan.putFromISR(data); }
+
+    Guard* getOutputGuard(const T& source) override {
+        if (SharedWriters) return sharedEndInAlt();
+        return chan.getOutputGuard(source);
+    }
+
+    bool pending() override { return chan.pending(); }
+};
+
+} // namespace csp::internal
+
+namespace csp {
+
+/**
+ * @brief Rendezvous channel written by several processes and read by one. Writers
+ * complete in arrival order; up to MaxWriters of them can be queued while one
+ * is in the channel, so at most MaxWriters + 1 processes may share the writing
+ * end. The reader may ALT on it.
+ *
+ *     static Any2OneChannel<Sample> samples;
+ *     static Gyro gyro(samples.writer());
+ *     static Accel accel(samples.writer());
+ *     static Detector detect(samples.reader());
+ */
+template <typename T, size_t MaxWriters = 4>
+class Any2OneChannel {
+private:
+    internal::SharedChannel<T, true, false, MaxWriters> internal_chan;
+public:
+    using Writer = Chanout<T, internal::SharedChannel<T, true, false, MaxWriters>>;
+    using Reader = Chanin<T, internal::SharedChannel<T, true, false, MaxWriters>>;
+
+    constexpr Any2OneChannel() = default;
+
+    Writer writer() { return Writer(&internal_chan); }
+    Reader reader() { return Reader(&internal_chan); }
+};
+
+/**
+ * @brief Rendezvous channel written by one process and read by several; each value
+ * goes to one reader, in the order the readers arrived. Up to MaxReaders readers
+ * can be queued behind the one in the channel. The writer may ALT on it.
+ */
+template <typename T, size_t MaxReaders = 4>
+class One2AnyChannel {
+private:
+    internal::SharedChannel<T, false, true, MaxReaders> internal_chan;
+public:
+    using Writer = Chanout<T, internal::SharedChannel<T, false, true, MaxReaders>>;
+    using Reader = Chanin<T, internal::SharedChannel<T, false, true, MaxReaders>>;
+
+    constexpr One2AnyChannel() = default;
+
+    Writer writer() { return Writer(&internal_chan); }
+    Reader reader() { return Reader(&internal_chan); }
+};
+
+/**
+ * @brief Rendezvous channel with both ends shared. Each end queues up to MaxWaiters
+ * processes behind the one in the channel. Neither end can be used in an ALT.
+ */
+template <typename T, size_t MaxWaiters = 4>
+class Any2AnyChannel {
+private:
+    internal::SharedChannel<T, true, true, MaxWaiters> internal_chan;
+public:
+    using Writer = Chanout<T, internal::SharedChannel<T, true, true, MaxWaiters>>;
+    using Reader = Chanin<T, internal::SharedChannel<T, true, true, MaxWaiters>>;
+
+    constexpr Any2AnyChannel() = default;
+
+    Writer writer() { return Writer(&internal_chan); }
+    Reader reader() { return Reader(&internal_chan); }
+};
+
+} // namespace csp
+
+#endif // CSP4CMSIS_SHARED_CHANNEL_H
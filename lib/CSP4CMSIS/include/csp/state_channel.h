@@ -0,0 +1,328 @@
+// --- state_channel.h ---
+#ifndef CSP4CMSIS_STATE_CHANNEL_H
+#define CSP4CMSIS_STATE_CHANNEL_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "alt.h"
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <cstdio>
+#include <type_traits>
+
+namespace csp {
+
+/**
+ * @brief Latest-value channel: one writer publishes state, any number of readers
+ * take a consistent snapshot of the newest value. Nothing is queued and the
+ * writer never waits for readers.
+ *
+ *     static StateChannel<Orientation> attitude;
+ *     attitude.writer() << o;                     // task or putFromISR()
+ *
+ *     auto rd = attitude.reader();                // one per consumer
+ *     rd.read(o);                                 // newest value, never blocks
+ *     rd.readNewer(o);                            // blocks until a newer one is published
+ *     Alternative alt(rd | o, timeout);           // ready when a newer one is published
+ *
+ * Publishing is a sequence-counter (seqlock) write: the counter is odd while the
+ * value is being replaced. The writer does this with interrupts masked, so it
+ * costs one copy of T and a reader on this core never has to wait for it. Readers
+ * copy without locking and retry if the counter moved underneath them.
+ *
+ * Readers blocked in readNewer() or an ALT are woken by the next publish; up to
+ * MaxWaiters of them can be waiting at once.
+ */
+template <typename T, size_t MaxWaiters = 4>
+class StateChannel;
+
+namespace internal {
+
+    template <typename T, size_t MaxWaiters>
+    class StateReaderGuard;
+
+} // namespace internal
+
+template <typename T, size_t MaxWaiters = 4>
+class StateReader {
+private:
+    StateChannel<T, MaxWaiters>* channel;
+    uint32_t seen;
+    internal::StateReaderGuard<T, MaxWaiters> guard;
+
+    friend class internal::StateReaderGuard<T, MaxWaiters>;
+
+public:
+    explicit StateReader(StateChannel<T, MaxWaiters>* chan)
+        : channel(chan), seen(0), guard(this) {}
+
+    StateReader(const StateReader& other)
+        : channel(other.channel), seen(other.seen), guard(this) {}
+
+    StateReader& operator=(const StateReader& other) {
+        channel = other.channel;
+        seen = other.seen;
+        return *this;
+    }
+
+    /**
+     * @brief Copies the newest value (T{} before the first publish).
+     * @return Its version: 0 before the first publish, then 1, 2, ...
+     */
+    uint32_t read(T& dest) {
+        seen = channel->snapshot(dest);
+        return seen;
+    }
+
+    void operator>>(T& dest) { read(dest); }
+
+    /**
+     * @brief Blocks until a value newer than the last one this reader saw is published.
+     */
+    uint32_t readNewer(T& dest) {
+        channel->waitNewer(seen, portMAX_DELAY);
+        return read(dest);
+    }
+
+    /**
+     * @brief As readNewer(), giving up after timeout; false (dest untouched) if nothing newer came.
+     */
+    bool readNewerFor(T& dest, Time timeout) {
+        if (!channel->waitNewer(seen, timeout.to_ticks())) return false;
+        read(dest);
+        return true;
+    }
+
+    /**
+     * @brief Version of the last value this reader took.
+     */
+    uint32_t version() const { return seen; }
+
+    internal::Guard* getGuard(T& dest) {
+        guard.setTarget(&dest);
+        return &guard;
+    }
+};
+
+template <typename T, size_t MaxWaiters = 4>
+class StateWriter {
+private:
+    StateChannel<T, MaxWaiters>* channel;
+
+public:
+    explicit StateWriter(StateChannel<T, MaxWaiters>* chan) : channel(chan) {}
+
+    void operator<<(const T& data) { channel->publish(data); }
+    void write(const T& data) { channel->publish(data); }
+
+    bool putFromISR(const T& data) {
+        channel->publishFromISR(data);
+        return true;
+    }
+};
+
+template <typename T, size_t MaxWaiters>
+class StateChannel {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "StateChannel: snapshots are plain copies that may be retried; T must be trivially copyable");
+    static_assert(MaxWaiters > 0, "StateChannel needs room for at least one waiting reader");
+
+private:
+    struct Waiter {
+        TaskHandle_t task;
+        internal::AltScheduler* alt;
+        EventBits_t bit;
+    };
+
+    volatile uint32_t seq;     // 2 * version, odd while a publish is in progress
+    T value;
+
+    Waiter waiters[MaxWaiters];
+    size_t num_waiters;
+
+    // Writes the value and takes the waiter list; called with interrupts masked.
+    size_t store(const T& data, Waiter* woken) {
+        uint32_t s = seq;
+        seq = s + 1;
+        std::atomic_thread_fence(std::memory_order_release);
+        value = data;
+        std::atomic_thread_fence(std::memory_order_release);
+        seq = s + 2;
+
+        size_t n = num_waiters;
+        for (size_t i = 0; i < n; i++) woken[i] = waiters[i];
+        num_waiters = 0;
+        return n;
+    }
+
+    // Called with interrupts masked.
+    bool addWaiter(TaskHandle_t task, internal::AltScheduler* alt, EventBits_t bit) {
+        if (num_waiters == MaxWaiters) return false;
+        waiters[num_waiters++] = Waiter{ task, alt, bit };
+        return true;
+    }
+
+    // Called with interrupts masked.
+    // False if the waiter was no longer listed: a publish has taken it off.
+    bool removeWaiter(TaskHandle_t task, internal::AltScheduler* alt) {
+        for (size_t i = 0; i < num_waiters; i++) {
+            if (waiters[i].task == task && waiters[i].alt == alt) {
+                waiters[i] = waiters[--num_waiters];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void tooManyWaiters() {
+        printf("CSP ERROR: StateChannel has more waiting readers than MaxWaiters.\r\n");
+        configASSERT(pdFALSE);
+    }
+
+    friend class StateReader<T, MaxWaiters>;
+    friend class StateWriter<T, MaxWaiters>;
+    friend class internal::StateReaderGuard<T, MaxWaiters>;
+
+public:
+    using Reader = StateReader<T, MaxWaiters>;
+    using Writer = StateWriter<T, MaxWaiters>;
+
+    constexpr StateChannel() : seq(0), value(), waiters{}, num_waiters(0) {}
+
+    StateChannel(const StateChannel&) = delete;
+    StateChannel& operator=(const StateChannel&) = delete;
+
+    Writer writer() { return Writer(this); }
+    Reader reader() { return Reader(this); }
+
+    uint32_t version() const { return seq / 2; }
+
+    void publish(const T& data) {
+        Waiter woken[MaxWaiters];
+        taskENTER_CRITICAL();
+        size_t n = store(data, woken);
+        taskEXIT_CRITICAL();
+
+        for (size_t i = 0; i < n; i++) {
+            if (woken[i].alt != nullptr) woken[i].alt->wakeUp(woken[i].bit);
+            else xTaskNotifyGive(woken[i].task);
+        }
+    }
+
+    void publishFromISR(const T& data) {
+        Waiter woken[MaxWaiters];
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+        size_t n = store(data, woken);
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+
+        for (size_t i = 0; i < n; i++) {
+            if (woken[i].alt != nullptr) woken[i].alt->wakeUp(woken[i].bit);
+            else vTaskNotifyGiveFromISR(woken[i].task, &xHigherPriorityTaskWoken);
+        }
+        portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    }
+
+private:
+    // Lock-free snapshot; returns the version copied.
+    uint32_t snapshot(T& dest) const {
+        while (true) {
+            uint32_t s = seq;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s & 1u) continue;            // only seen from a context that interrupted the writer
+            dest = value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq == s) return s / 2;
+        }
+    }
+
+    // Blocks until version() > seen or timeout; true if newer.
+    bool waitNewer(uint32_t seen, TickType_t timeout) {
+        TimeOut_t start;
+        vTaskSetTimeOutState(&start);
+        TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+        while (true) {
+            xTaskNotifyStateClear(NULL);
+            taskENTER_CRITICAL();
+            bool newer = version() > seen;
+            bool registered = !newer && addWaiter(self, nullptr, 0);
+            taskEXIT_CRITICAL();
+
+            if (newer) return true;
+            if (!registered) tooManyWaiters();
+
+            bool notified = false;
+            if (timeout != 0 && xTaskCheckForTimeOut(&start, &timeout) == pdFALSE) {
+                notified = ulTaskNotifyTake(pdTRUE, timeout) != 0;   // a publish or the timeout
+            }
+
+            // A publish has already taken us off the list; after a timeout we remove ourselves
+            taskENTER_CRITICAL();
+            bool listed = removeWaiter(self, nullptr);
+            newer = version() > seen;
+            taskEXIT_CRITICAL();
+
+            // Taken off by a publish whose notification is still on its way: take it,
+            // or the next notification wait would return early
+            if (!listed && !notified) ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+            if (newer) return true;
+            if (timeout == 0 || xTaskCheckForTimeOut(&start, &timeout) == pdTRUE) return false;
+        }
+    }
+};
+
+namespace internal {
+
+    /**
+     * @brief ALT guard of one StateReader: ready once a value newer than the
+     * reader's last one has been published.
+     */
+    template <typename T, size_t MaxWaiters>
+    class StateReaderGuard final : public Guard {
+    private:
+        StateReader<T, MaxWaiters>* reader;
+        T* dest_ptr = nullptr;
+        AltScheduler* alt = nullptr;
+
+    public:
+        explicit StateReaderGuard(StateReader<T, MaxWaiters>* r) : reader(r) {}
+        void setTarget(T* dest) { dest_ptr = dest; }
+
+        bool enable(AltScheduler* a, EventBits_t bit) override {
+            StateChannel<T, MaxWaiters>* chan = reader->channel;
+            taskENTER_CRITICAL();
+            bool ready = chan->version() > reader->seen;
+            bool registered = ready || chan->addWaiter(nullptr, a, bit);
+            alt = (ready || !registered) ? nullptr : a;
+            taskEXIT_CRITICAL();
+            if (!registered) StateChannel<T, MaxWaiters>::tooManyWaiters();
+            return ready;
+        }
+        bool disable() override {
+            StateChannel<T, MaxWaiters>* chan = reader->channel;
+            taskENTER_CRITICAL();
+            if (alt != nullptr) chan->removeWaiter(nullptr, alt);
+            alt = nullptr;
+            bool ready = chan->version() > reader->seen;
+            taskEXIT_CRITICAL();
+            return ready;
+        }
+        void activate() override {
+            reader->read(*dest_ptr);
+        }
+    };
+
+} // namespace internal
+
+template <typename T, size_t MaxWaiters>
+ChannelBinding<T, StateReader<T, MaxWaiters>> operator|(StateReader<T, MaxWaiters>& reader, T& dest) {
+    return ChannelBinding<T, StateReader<T, MaxWaiters>>(reader, dest);
+}
+
+} // namespace csp
+
+#endif // CSP4CMSIS_STATE_CHANNEL_H
@@ -0,0 +1,137 @@
+// --- static_alloc.h ---
+#ifndef CSP4CMSIS_STATIC_ALLOC_H
+#define CSP4CMSIS_STATIC_ALLOC_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include <stddef.h>
+#include <stdint.h>
+
+namespace csp::internal {
+
+    /**
+     * @brief Statically allocated FreeRTOS objects for the library's channels and barriers.
+     *
+     * Each wrapper embeds its Static*_t control block and has a constexpr constructor,
+     * so objects declared at namespace scope are constant-initialised and never touch
+     * the kernel before the scheduler exists. The kernel object is created with the
+     * *CreateStatic API on first get(), which must come from a task. ISR paths use
+     * created() and treat a not-yet-created object as having no partner.
+     */
+    class StaticMutex {
+    private:
+        StaticSemaphore_t storage;
+        SemaphoreHandle_t handle;
+
+    public:
+        constexpr StaticMutex() : storage{}, handle(nullptr) {}
+        ~StaticMutex() { if (handle != nullptr) vSemaphoreDelete(handle); }
+
+        StaticMutex(const StaticMutex&) = delete;
+        StaticMutex& operator=(const StaticMutex&) = delete;
+
+        SemaphoreHandle_t get() {
+            if (handle == nullptr) {
+                taskENTER_CRITICAL();
+                if (handle == nullptr) handle = xSemaphoreCreateMutexStatic(&storage);
+                taskEXIT_CRITICAL();
+            }
+            return handle;
+        }
+
+        SemaphoreHandle_t created() const { return handle; }
+    };
+
+    class StaticCountingSemaphore {
+    private:
+        StaticSemaphore_t storage;
+        SemaphoreHandle_t handle;
+        UBaseType_t max_count;
+        UBaseType_t initial_count;
+
+    public:
+        constexpr StaticCountingSemaphore(UBaseType_t max, UBaseType_t initial)
+            : storage{}, handle(nullptr), max_count(max), initial_count(initial) {}
+        ~StaticCountingSemaphore() { if (handle != nullptr) vSemaphoreDelete(handle); }
+
+        StaticCountingSemaphore(const StaticCountingSemaphore&) = delete;
+        StaticCountingSemaphore& operator=(const StaticCountingSemaphore&) = delete;
+
+        SemaphoreHandle_t get() {
+            if (handle == nullptr) {
+                taskENTER_CRITICAL();
+                if (handle == nullptr) {
+                    handle = xSemaphoreCreateCountingStatic(max_count, initial_count, &storage);
+                }
+                taskEXIT_CRITICAL();
+            }
+            return handle;
+        }
+
+        SemaphoreHandle_t created() const { return handle; }
+    };
+
+    /**
+     * @brief Queue over caller-provided item storage (length * item_size bytes,
+     * may be nullptr when item_size is 0).
+     */
+    class StaticQueue {
+    private:
+        StaticQueue_t storage;
+        QueueHandle_t handle;
+        UBaseType_t length;
+        UBaseType_t item_size;
+        uint8_t* item_storage;
+
+    public:
+        constexpr StaticQueue(UBaseType_t len, UBaseType_t size, uint8_t* items)
+            : storage{}, handle(nullptr), length(len), item_size(size), item_storage(items) {}
+        ~StaticQueue() { if (handle != nullptr) vQueueDelete(handle); }
+
+        StaticQueue(const StaticQueue&) = delete;
+        StaticQueue& operator=(const StaticQueue&) = delete;
+
+        QueueHandle_t get() {
+            if (handle == nullptr) {
+                taskENTER_CRITICAL();
+                if (handle == nullptr) {
+                    handle = xQueueCreateStatic(length, item_size, item_storage, &storage);
+                }
+                taskEXIT_CRITICAL();
+            }
+            return handle;
+        }
+
+        QueueHandle_t created() const { return handle; }
+    };
+
+    class StaticEventGroup {
+    private:
+        StaticEventGroup_t storage;
+        EventGroupHandle_t handle;
+
+    public:
+        constexpr StaticEventGroup() : storage{}, handle(nullptr) {}
+        ~StaticEventGroup() { if (handle != nullptr) vEventGroupDelete(handle); }
+
+        StaticEventGroup(const StaticEventGroup&) = delete;
+        StaticEventGroup& operator=(const StaticEventGroup&) = delete;
+
+        EventGroupHandle_t get() {
+            if (handle == nullptr) {
+                taskENTER_CRITICAL();
+                if (handle == nullptr) handle = xEventGroupCreateStatic(&storage);
+                taskEXIT_CRITICAL();
+            }
+            return handle;
+        }
+
+        EventGroupHandle_t created() const { return handle; }
+    };
+
+} // namespace csp::internal
+
+#endif // CSP4CMSIS_STATIC_ALLOC_H
@@ -3,6 +3,7 @@
 
 #include "channel_base.h"
 #include "alt.h"
+#include "static_alloc.h"
 #include "FreeRTOS.h"
 #include "semphr.h"
 #include "queue.h"
@@ -18,7 +19,7 @@ namespace csp::internal {
         size_t data_size = 0;
         AltScheduler* parent_alt = nullptr; // Required for disable()
     public:
-        SyncChannelInputGuard(SyncChannel* chan) : channel(chan) {}
+        constexpr SyncChannelInputGuard(SyncChannel* chan) : channel(chan) {}
         void bind(void* dest, size_t size) { user_data_dest = dest; data_size = size; }
         bool enable(AltScheduler* alt, EventBits_t bit) override; 
         bool disable() override;
@@ -32,7 +33,7 @@ namespace csp::internal {
         size_t data_size = 0;
         AltScheduler* parent_alt = nullptr; // Required for disable()
     public:
-        SyncChannelOutputGuard(SyncChannel* chan) : channel(chan) {}
+        constexpr SyncChannelOutputGuard(SyncChannel* chan) : channel(chan) {}
         void bind(const void* src, size_t size) { user_data_source = src; data_size = size; }
         bool enable(AltScheduler* alt, EventBits_t bit) override;
         bool disable() override;
@@ -43,7 +44,7 @@ namespace csp::internal {
     public:
         enum State { IDLE, SENDER_WAITING, RECEIVER_WAITING };
     private:
-        SemaphoreHandle_t mutex;
+        StaticMutex mutex;
         State state;
         const void* data_ptr = nullptr;
         size_t data_len = 0;
@@ -56,15 +57,22 @@ namespace csp::internal {
         EventBits_t waiting_alt_bit_out = 0;
         SyncChannelOutputGuard* waiting_guard_out = nullptr; // ADDED
         
-        QueueHandle_t sender_queue; 
-        QueueHandle_t receiver_queue; 
+        StaticQueue sender_queue; 
+        StaticQueue receiver_queue; 
 
         SyncChannelInputGuard  res_in_guard;
         SyncChannelOutputGuard res_out_guard;
 
     public:
-        SyncChannel();
-        ~SyncChannel() override;
+        constexpr SyncChannel()
+            : mutex(),
+              state(IDLE),
+              sender_queue(1, 0, nullptr),
+              receiver_queue(1, 0, nullptr),
+              res_in_guard(this),
+              res_out_guard(this)
+        {}
+        ~SyncChannel() override = default;
         void reset();
 
         Guard* getInputGuard() override { return &res_in_guard; }
@@ -72,19 +80,19 @@ namespace csp::internal {
         
         void input(void* const dest) override;
         void output(const void* const source) override;
-        void beginExtInput(void* const dest) override { input(dest); }
-        void endExtInput() override {}
+        const void* beginExtInput() override;
+        void endExtInput() override;
 
         bool registerAltIn(AltScheduler* alt, EventBits_t bit, SyncChannelInputGuard* guard);
         bool unregisterAltIn(AltScheduler* alt);
         bool registerAltOut(AltScheduler* alt, EventBits_t bit, SyncChannelOutputGuard* guard);
         bool unregisterAltOut(AltScheduler* alt);
 
-        SemaphoreHandle_t getMutex() { return mutex; }
+        SemaphoreHandle_t getMutex() { return mutex.get(); }
         State getState() { return state; }
         const void* getDataPtr() { return data_ptr; }
-        QueueHandle_t getSenderQueue() { return sender_queue; }
-        QueueHandle_t getReceiverQueue() { return receiver_queue; }
+        QueueHandle_t getSenderQueue() { return sender_queue.get(); }
+        QueueHandle_t getReceiverQueue() { return receiver_queue.get(); }
         void setChannelData(const void* ptr, size_t len) { data_ptr = ptr; data_len = len; }
     };
 }
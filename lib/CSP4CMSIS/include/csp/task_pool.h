@@ -0,0 +1,49 @@
+// --- task_pool.h ---
+#ifndef CSP4CMSIS_TASK_POOL_H
+#define CSP4CMSIS_TASK_POOL_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "process.h"
+#include <stddef.h>
+
+// Worker tasks kept for the forked processes of terminating networks (0 disables the pool).
+#ifndef CSP_TASK_POOL_SIZE
+#define CSP_TASK_POOL_SIZE 4
+#endif
+
+// Stack depth (in words) of each pool worker. A process declaring more gets its own task.
+#ifndef CSP_TASK_POOL_STACK_WORDS
+#define CSP_TASK_POOL_STACK_WORDS CSP_DEFAULT_STACK_WORDS
+#endif
+
+namespace csp::internal {
+
+    /**
+     * @brief Static worker tasks that Run(InParallel(...)) forks processes onto.
+     *
+     * A worker is created on the first dispatch that finds the pool empty, up to
+     * CSP_TASK_POOL_SIZE, and is never deleted: after its process returns it goes
+     * back on the free list, gives the network's completion semaphore and waits
+     * for the next job on its task notification. A fork/join then costs a
+     * notification and a semaphore give instead of creating and deleting a task.
+     */
+    class TaskPool {
+    private:
+        static void workerLoop(void* pvParameters);
+
+    public:
+        /**
+         * @brief Runs process on an idle worker at the given priority; the worker
+         * gives done when it returns.
+         * @return false if every worker is busy: the caller creates a task instead.
+         */
+        static bool dispatch(CSProcess* process, SemaphoreHandle_t done, UBaseType_t priority);
+
+        static size_t workersCreated();
+    };
+
+} // namespace csp::internal
+
+#endif // CSP4CMSIS_TASK_POOL_H
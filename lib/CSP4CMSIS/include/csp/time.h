@@ -5,6 +5,7 @@
 // These two includes should remain outside the C++ block as they are C headers
 // and provide the C type TickType_t.
 #include "FreeRTOS.h"
+#include "task.h"
 #include <stdint.h>
 
 // ------------------------------------------------------------------
@@ -53,6 +54,17 @@ inline Time Milliseconds(uint32_t ms) {
     return Time((TickType_t) ((ms * configTICK_RATE_HZ) / 1000));
 }
 
+/**
+ * @brief The current tick count, as an absolute time point for AbsTimeoutGuard.
+ */
+inline Time Now() {
+    return Time(xTaskGetTickCount());
+}
+
+inline Time operator+(Time a, Time b) {
+    return Time(a.ticks + b.ticks);
+}
+
 } // namespace csp
 #endif // __cplusplus
 
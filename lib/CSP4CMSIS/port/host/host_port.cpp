@@ -0,0 +1,594 @@
+// --- host_port.cpp ---
+// FreeRTOS API on std::thread: see include/FreeRTOS.h in this directory.
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <pthread.h>
+
+struct tskTaskControlBlock {
+    enum NotifyState : uint8_t { NOT_WAITING, WAITING, RECEIVED };
+
+    std::mutex lock;
+    std::condition_variable wake;
+    uint32_t notify_value = 0;
+    NotifyState notify_state = NOT_WAITING;
+    bool deleted = false;                    // Leave at the next suspension or notification wait
+
+    std::atomic<UBaseType_t> priority{ tskIDLE_PRIORITY };
+    char name[configMAX_TASK_NAME_LEN] = {};
+    TaskFunction_t code = nullptr;
+    void* parameters = nullptr;
+};
+
+struct QueueDefinition {
+    std::mutex lock;
+    std::condition_variable changed;         // Items or spaces appeared
+    uint8_t* storage;
+    UBaseType_t length;
+    UBaseType_t item_size;                   // 0 for semaphores: only the count matters
+    UBaseType_t count = 0;
+    UBaseType_t head = 0;
+    bool is_static;
+    bool owns_storage;
+    bool is_mutex = false;
+    TaskHandle_t holder = nullptr;
+
+    QueueDefinition(UBaseType_t len, UBaseType_t size, uint8_t* buf, bool st)
+        : storage(buf), length(len), item_size(size), is_static(st), owns_storage(false) {}
+    ~QueueDefinition() { if (owns_storage) std::free(storage); }
+};
+
+struct EventGroupDef_t {
+    std::mutex lock;
+    std::condition_variable changed;
+    EventBits_t bits = 0;
+    bool is_static;
+
+    explicit EventGroupDef_t(bool st) : is_static(st) {}
+};
+
+static_assert(sizeof(QueueDefinition) <= sizeof(StaticQueue_t), "host port: StaticQueue_t too small");
+static_assert(alignof(QueueDefinition) <= alignof(StaticQueue_t), "host port: StaticQueue_t misaligned");
+static_assert(sizeof(EventGroupDef_t) <= sizeof(StaticEventGroup_t), "host port: StaticEventGroup_t too small");
+static_assert(alignof(EventGroupDef_t) <= alignof(StaticEventGroup_t), "host port: StaticEventGroup_t misaligned");
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+    using Lock = std::unique_lock<std::mutex>;
+
+    const Clock::time_point start_time = Clock::now();
+
+    std::recursive_mutex critical_lock;
+    thread_local bool in_interrupt = false;
+
+    // The task a thread runs, created on first use for threads the port did not
+    // start (main() and other foreign threads). Owned here, freed when the thread ends.
+    thread_local std::unique_ptr<tskTaskControlBlock> current_task;
+
+    TaskHandle_t currentTask() {
+        if (!current_task) {
+            current_task.reset(new tskTaskControlBlock());
+            std::strncpy(current_task->name, "host", configMAX_TASK_NAME_LEN - 1);
+        }
+        return current_task.get();
+    }
+
+    // Waits on cv until pred() holds or the block time runs out; false on timeout.
+    template <typename Pred>
+    bool waitFor(std::condition_variable& cv, Lock& lk, TickType_t ticks, Pred pred) {
+        if (pred()) return true;
+        if (ticks == 0) return false;
+        if (ticks == portMAX_DELAY) {
+            cv.wait(lk, pred);
+            return true;
+        }
+        return cv.wait_for(lk, std::chrono::milliseconds(ticks), pred);
+    }
+
+    // Ends the calling task's thread; current_task frees its control block on the way out.
+    [[noreturn]] void exitTask() {
+        pthread_exit(nullptr);
+    }
+
+    void taskEntry(tskTaskControlBlock* tcb) {
+        current_task.reset(tcb);
+        tcb->code(tcb->parameters);
+        // FreeRTOS tasks must not return; treat it as deleting itself.
+        current_task.reset();
+    }
+
+    // Called with tcb->lock held.
+    BaseType_t notifyLocked(tskTaskControlBlock* tcb, uint32_t value, eNotifyAction action, uint32_t* previous) {
+        if (previous != nullptr) *previous = tcb->notify_value;
+
+        const bool was_received = tcb->notify_state == tskTaskControlBlock::RECEIVED;
+        switch (action) {
+            case eSetBits:                  tcb->notify_value |= value; break;
+            case eIncrement:                tcb->notify_value++; break;
+            case eSetValueWithOverwrite:    tcb->notify_value = value; break;
+            case eSetValueWithoutOverwrite:
+                if (was_received) return pdFAIL;
+                tcb->notify_value = value;
+                break;
+            case eNoAction:                 break;
+        }
+        tcb->notify_state = tskTaskControlBlock::RECEIVED;
+        tcb->wake.notify_all();
+        return pdPASS;
+    }
+
+    // --- Queue helpers, called with q->lock held ---
+
+    void copyIn(QueueDefinition* q, const void* item, bool to_front) {
+        UBaseType_t slot;
+        if (to_front) {
+            q->head = (q->head + q->length - 1) % q->length;
+            slot = q->head;
+        } else {
+            slot = (q->head + q->count) % q->length;
+        }
+        if (q->item_size != 0 && item != nullptr) {
+            std::memcpy(q->storage + slot * q->item_size, item, q->item_size);
+        }
+        q->count++;
+    }
+
+    void copyOut(QueueDefinition* q, void* buffer, bool peek) {
+        if (q->item_size != 0 && buffer != nullptr) {
+            std::memcpy(buffer, q->storage + q->head * q->item_size, q->item_size);
+        }
+        if (!peek) {
+            q->head = (q->head + 1) % q->length;
+            q->count--;
+        }
+    }
+
+    QueueDefinition* makeQueue(UBaseType_t length, UBaseType_t item_size, uint8_t* storage, StaticQueue_t* buffer) {
+        QueueDefinition* q;
+        if (buffer != nullptr) {
+            q = new (buffer) QueueDefinition(length, item_size, storage, true);
+        } else {
+            q = new QueueDefinition(length, item_size, nullptr, false);
+        }
+        if (item_size != 0 && q->storage == nullptr) {
+            q->storage = static_cast<uint8_t*>(std::malloc(length * item_size));
+            q->owns_storage = true;
+        }
+        return q;
+    }
+
+    BaseType_t send(QueueDefinition* q, const void* item, TickType_t ticks, bool to_front) {
+        Lock lk(q->lock);
+        if (!waitFor(q->changed, lk, ticks, [q] { return q->count < q->length; })) return errQUEUE_FULL;
+        copyIn(q, item, to_front);
+        if (q->is_mutex) q->holder = nullptr;
+        q->changed.notify_all();
+        return pdPASS;
+    }
+
+    BaseType_t receive(QueueDefinition* q, void* buffer, TickType_t ticks, bool peek) {
+        Lock lk(q->lock);
+        if (!waitFor(q->changed, lk, ticks, [q] { return q->count > 0; })) return errQUEUE_EMPTY;
+        copyOut(q, buffer, peek);
+        if (q->is_mutex && !peek) q->holder = currentTask();
+        q->changed.notify_all();
+        return pdPASS;
+    }
+
+    QueueDefinition* makeSemaphore(UBaseType_t max, UBaseType_t initial, StaticSemaphore_t* buffer) {
+        QueueDefinition* q = makeQueue(max, 0, nullptr, buffer);
+        q->count = initial;
+        return q;
+    }
+
+} // namespace
+
+extern "C" {
+
+// =============================================================
+//  Port layer
+// =============================================================
+
+void vAssertCalled(const char* pcExpression, const char* pcFile, int ulLine) {
+    std::fprintf(stderr, "configASSERT(%s) failed at %s:%d\n", pcExpression, pcFile, ulLine);
+    std::fflush(stdout);
+    std::abort();
+}
+
+void vPortEnterCritical(void) { critical_lock.lock(); }
+void vPortExitCritical(void) { critical_lock.unlock(); }
+
+UBaseType_t uxPortSetInterruptMaskFromISR(void) {
+    critical_lock.lock();
+    return 0;
+}
+
+void vPortClearInterruptMaskFromISR(UBaseType_t) { critical_lock.unlock(); }
+
+BaseType_t xPortIsInsideInterrupt(void) { return in_interrupt ? pdTRUE : pdFALSE; }
+
+void vPortYield(void) { std::this_thread::yield(); }
+
+void* pvPortMalloc(size_t xSize) { return std::malloc(xSize); }
+void vPortFree(void* pv) { std::free(pv); }
+
+void vPortRunAsInterrupt(void (*handler)(void*), void* arg) {
+    const bool was_in_interrupt = in_interrupt;
+    in_interrupt = true;
+    handler(arg);
+    in_interrupt = was_in_interrupt;
+}
+
+// =============================================================
+//  Tasks
+// =============================================================
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char* pcName, uint16_t usStackDepth,
+                       void* pvParameters, UBaseType_t uxPriority, TaskHandle_t* pxCreatedTask) {
+    TaskHandle_t handle = xTaskCreateStatic(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+                                            nullptr, nullptr);
+    if (pxCreatedTask != nullptr) *pxCreatedTask = handle;
+    return handle != nullptr ? pdPASS : pdFAIL;
+}
+
+// The stack and TCB buffers are not used: the thread has its own stack, and the
+// control block lives until the thread has left, which may be after vTaskDelete().
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char* pcName, uint32_t,
+                               void* pvParameters, UBaseType_t uxPriority,
+                               StackType_t*, StaticTask_t*) {
+    configASSERT(uxPriority < configMAX_PRIORITIES);
+
+    tskTaskControlBlock* tcb = new tskTaskControlBlock();
+    if (pcName != nullptr) std::strncpy(tcb->name, pcName, configMAX_TASK_NAME_LEN - 1);
+    tcb->priority = uxPriority;
+    tcb->code = pxTaskCode;
+    tcb->parameters = pvParameters;
+
+    std::thread(taskEntry, tcb).detach();
+    return tcb;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete) {
+    TaskHandle_t self = currentTask();
+    if (xTaskToDelete == nullptr || xTaskToDelete == self) exitTask();
+
+    // The task leaves at its next suspension or notification wait; after
+    // the unlock below its control block may be gone.
+    Lock lk(xTaskToDelete->lock);
+    xTaskToDelete->deleted = true;
+    xTaskToDelete->wake.notify_all();
+}
+
+// Only a task suspending itself is supported: it waits until it is deleted.
+void vTaskSuspend(TaskHandle_t xTaskToSuspend) {
+    TaskHandle_t self = currentTask();
+    configASSERT(xTaskToSuspend == nullptr || xTaskToSuspend == self);
+
+    Lock lk(self->lock);
+    self->wake.wait(lk, [self] { return self->deleted; });
+    lk.unlock();
+    exitTask();
+}
+
+void vTaskDelay(TickType_t xTicksToDelay) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(xTicksToDelay));
+}
+
+void vTaskDelayUntil(TickType_t* pxPreviousWakeTime, TickType_t xTimeIncrement) {
+    *pxPreviousWakeTime += xTimeIncrement;
+    TickType_t remaining = *pxPreviousWakeTime - xTaskGetTickCount();
+    if ((int32_t)remaining > 0) vTaskDelay(remaining);
+}
+
+// Tasks run from the moment they are created; the caller just stays here.
+void vTaskStartScheduler(void) {
+    for (;;) std::this_thread::sleep_for(std::chrono::hours(1));
+}
+
+TickType_t xTaskGetTickCount(void) {
+    return (TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start_time).count();
+}
+
+TickType_t xTaskGetTickCountFromISR(void) { return xTaskGetTickCount(); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return currentTask(); }
+
+char* pcTaskGetName(TaskHandle_t xTaskToQuery) {
+    return (xTaskToQuery != nullptr ? xTaskToQuery : currentTask())->name;
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t xTask) {
+    return (xTask != nullptr ? xTask : currentTask())->priority;
+}
+
+void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority) {
+    configASSERT(uxNewPriority < configMAX_PRIORITIES);
+    (xTask != nullptr ? xTask : currentTask())->priority = uxNewPriority;
+}
+
+void vTaskSetTimeOutState(TimeOut_t* pxTimeOut) {
+    pxTimeOut->xOverflowCount = 0;
+    pxTimeOut->xTimeOnEntering = xTaskGetTickCount();
+}
+
+BaseType_t xTaskCheckForTimeOut(TimeOut_t* pxTimeOut, TickType_t* pxTicksToWait) {
+    if (*pxTicksToWait == portMAX_DELAY) return pdFALSE;
+
+    const TickType_t now = xTaskGetTickCount();
+    const TickType_t elapsed = now - pxTimeOut->xTimeOnEntering;
+    if (elapsed < *pxTicksToWait) {
+        *pxTicksToWait -= elapsed;
+        pxTimeOut->xTimeOnEntering = now;
+        return pdFALSE;
+    }
+    *pxTicksToWait = 0;
+    return pdTRUE;
+}
+
+// =============================================================
+//  Task notifications
+// =============================================================
+
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                              uint32_t* pulPreviousNotificationValue) {
+    Lock lk(xTaskToNotify->lock);
+    return notifyLocked(xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue);
+}
+
+BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction,
+                                     uint32_t* pulPreviousNotificationValue,
+                                     BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) *pxHigherPriorityTaskWoken = pdTRUE;
+    return xTaskGenericNotify(xTaskToNotify, ulValue, eAction, pulPreviousNotificationValue);
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t* pxHigherPriorityTaskWoken) {
+    xTaskGenericNotifyFromISR(xTaskToNotify, 0, eIncrement, nullptr, pxHigherPriorityTaskWoken);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait) {
+    TaskHandle_t self = currentTask();
+    Lock lk(self->lock);
+
+    self->notify_state = tskTaskControlBlock::WAITING;
+    waitFor(self->wake, lk, xTicksToWait, [self] { return self->notify_value != 0 || self->deleted; });
+    if (self->deleted) {
+        lk.unlock();
+        exitTask();
+    }
+
+    const uint32_t value = self->notify_value;
+    if (value != 0) self->notify_value = xClearCountOnExit ? 0 : value - 1;
+    self->notify_state = tskTaskControlBlock::NOT_WAITING;
+    return value;
+}
+
+BaseType_t xTaskNotifyWait(uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit,
+                           uint32_t* pulNotificationValue, TickType_t xTicksToWait) {
+    TaskHandle_t self = currentTask();
+    Lock lk(self->lock);
+
+    if (self->notify_state != tskTaskControlBlock::RECEIVED) {
+        self->notify_value &= ~ulBitsToClearOnEntry;
+        self->notify_state = tskTaskControlBlock::WAITING;
+    }
+    waitFor(self->wake, lk, xTicksToWait,
+            [self] { return self->notify_state == tskTaskControlBlock::RECEIVED || self->deleted; });
+    if (self->deleted) {
+        lk.unlock();
+        exitTask();
+    }
+
+    if (pulNotificationValue != nullptr) *pulNotificationValue = self->notify_value;
+    const bool received = self->notify_state == tskTaskControlBlock::RECEIVED;
+    if (received) self->notify_value &= ~ulBitsToClearOnExit;
+    self->notify_state = tskTaskControlBlock::NOT_WAITING;
+    return received ? pdTRUE : pdFALSE;
+}
+
+BaseType_t xTaskNotifyStateClear(TaskHandle_t xTask) {
+    TaskHandle_t tcb = xTask != nullptr ? xTask : currentTask();
+    Lock lk(tcb->lock);
+    if (tcb->notify_state != tskTaskControlBlock::RECEIVED) return pdFAIL;
+    tcb->notify_state = tskTaskControlBlock::NOT_WAITING;
+    return pdPASS;
+}
+
+// =============================================================
+//  Queues and semaphores
+// =============================================================
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize) {
+    return makeQueue(uxQueueLength, uxItemSize, nullptr, nullptr);
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize,
+                                 uint8_t* pucQueueStorage, StaticQueue_t* pxStaticQueue) {
+    return makeQueue(uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue);
+}
+
+void vQueueDelete(QueueHandle_t xQueue) {
+    if (xQueue->is_static) {
+        xQueue->~QueueDefinition();
+    } else {
+        delete xQueue;
+    }
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait) {
+    return send(xQueue, pvItemToQueue, xTicksToWait, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t xQueue, const void* pvItemToQueue, TickType_t xTicksToWait) {
+    return send(xQueue, pvItemToQueue, xTicksToWait, true);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t xQueue, const void* pvItemToQueue) {
+    Lock lk(xQueue->lock);
+    configASSERT(xQueue->length == 1);
+    xQueue->count = 0;
+    xQueue->head = 0;
+    copyIn(xQueue, pvItemToQueue, false);
+    xQueue->changed.notify_all();
+    return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void* pvItemToQueue,
+                             BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) *pxHigherPriorityTaskWoken = pdTRUE;
+    return send(xQueue, pvItemToQueue, 0, false);
+}
+
+BaseType_t xQueueOverwriteFromISR(QueueHandle_t xQueue, const void* pvItemToQueue,
+                                  BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) *pxHigherPriorityTaskWoken = pdTRUE;
+    return xQueueOverwrite(xQueue, pvItemToQueue);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    return receive(xQueue, pvBuffer, xTicksToWait, false);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void* pvBuffer, BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) *pxHigherPriorityTaskWoken = pdTRUE;
+    return receive(xQueue, pvBuffer, 0, false);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t xQueue, void* pvBuffer, TickType_t xTicksToWait) {
+    return receive(xQueue, pvBuffer, xTicksToWait, true);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue) {
+    Lock lk(xQueue->lock);
+    return xQueue->count;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t xQueue) { return uxQueueMessagesWaiting(xQueue); }
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t xQueue) {
+    Lock lk(xQueue->lock);
+    return xQueue->length - xQueue->count;
+}
+
+BaseType_t xQueueReset(QueueHandle_t xQueue) {
+    Lock lk(xQueue->lock);
+    xQueue->count = 0;
+    xQueue->head = 0;
+    xQueue->changed.notify_all();
+    return pdPASS;
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) { return xSemaphoreCreateMutexStatic(nullptr); }
+
+SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* pxMutexBuffer) {
+    QueueDefinition* q = makeSemaphore(1, 1, pxMutexBuffer);
+    q->is_mutex = true;
+    return q;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) { return makeSemaphore(1, 0, nullptr); }
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t* pxSemaphoreBuffer) {
+    return makeSemaphore(1, 0, pxSemaphoreBuffer);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount) {
+    return makeSemaphore(uxMaxCount, uxInitialCount, nullptr);
+}
+
+SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount,
+                                                 StaticSemaphore_t* pxSemaphoreBuffer) {
+    return makeSemaphore(uxMaxCount, uxInitialCount, pxSemaphoreBuffer);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime) {
+    return receive(xSemaphore, nullptr, xBlockTime, false);
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore) {
+    return send(xSemaphore, nullptr, 0, false);
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t xSemaphore, BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) *pxHigherPriorityTaskWoken = pdTRUE;
+    return xSemaphoreGive(xSemaphore);
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t xSemaphore) {
+    Lock lk(xSemaphore->lock);
+    return xSemaphore->holder;
+}
+
+// =============================================================
+//  Event groups
+// =============================================================
+
+EventGroupHandle_t xEventGroupCreate(void) { return new EventGroupDef_t(false); }
+
+EventGroupHandle_t xEventGroupCreateStatic(StaticEventGroup_t* pxEventGroupBuffer) {
+    return new (pxEventGroupBuffer) EventGroupDef_t(true);
+}
+
+void vEventGroupDelete(EventGroupHandle_t xEventGroup) {
+    if (xEventGroup->is_static) {
+        xEventGroup->~EventGroupDef_t();
+    } else {
+        delete xEventGroup;
+    }
+}
+
+EventBits_t xEventGroupSetBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet) {
+    Lock lk(xEventGroup->lock);
+    xEventGroup->bits |= uxBitsToSet;
+    xEventGroup->changed.notify_all();
+    return xEventGroup->bits;
+}
+
+BaseType_t xEventGroupSetBitsFromISR(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToSet,
+                                     BaseType_t* pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) *pxHigherPriorityTaskWoken = pdTRUE;
+    xEventGroupSetBits(xEventGroup, uxBitsToSet);
+    return pdPASS;
+}
+
+EventBits_t xEventGroupClearBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToClear) {
+    Lock lk(xEventGroup->lock);
+    const EventBits_t before = xEventGroup->bits;
+    xEventGroup->bits &= ~uxBitsToClear;
+    return before;
+}
+
+EventBits_t xEventGroupGetBits(EventGroupHandle_t xEventGroup) {
+    Lock lk(xEventGroup->lock);
+    return xEventGroup->bits;
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, EventBits_t uxBitsToWaitFor,
+                                BaseType_t xClearOnExit, BaseType_t xWaitForAllBits, TickType_t xTicksToWait) {
+    Lock lk(xEventGroup->lock);
+    auto satisfied = [&] {
+        const EventBits_t set = xEventGroup->bits & uxBitsToWaitFor;
+        return xWaitForAllBits ? set == uxBitsToWaitFor : set != 0;
+    };
+    const bool ok = waitFor(xEventGroup->changed, lk, xTicksToWait, satisfied);
+    const EventBits_t bits = xEventGroup->bits;
+    if (ok && xClearOnExit) xEventGroup->bits &= ~uxBitsToWaitFor;
+    return bits;
+}
+
+} // extern "C"
@@ -0,0 +1,99 @@
+// --- FreeRTOS.h (host port) ---
+#ifndef CSP4CMSIS_HOST_FREERTOS_H
+#define CSP4CMSIS_HOST_FREERTOS_H
+
+/**
+ * The subset of the FreeRTOS API that CSP4CMSIS uses, implemented on std::thread
+ * for running process networks natively on a multi-core Linux host.
+ *
+ * Every task is a thread, and all of them run in parallel: priorities are
+ * recorded but not scheduled. Each task, queue/semaphore and event group has
+ * its own mutex and condition variable, so independent networks do not contend.
+ * A critical section is one process-wide recursive lock; it excludes other
+ * critical sections, not other tasks. One tick is one millisecond.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;       // As on the Cortex-M4, so stack budgets match the target
+typedef uint32_t EventBits_t;
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef struct QueueDefinition* QueueHandle_t;
+typedef struct QueueDefinition* SemaphoreHandle_t;
+typedef struct EventGroupDef_t* EventGroupHandle_t;
+
+typedef void (*TaskFunction_t)(void*);
+
+// Storage the static creation functions build their object in. Tasks keep
+// their state on the heap instead, since it must outlive vTaskDelete() until
+// the thread has left.
+typedef struct { alignas(16) unsigned char opaque[16]; } StaticTask_t;
+typedef struct { alignas(16) unsigned char opaque[256]; } StaticQueue_t;
+typedef StaticQueue_t StaticSemaphore_t;
+typedef struct { alignas(16) unsigned char opaque[192]; } StaticEventGroup_t;
+
+#define pdTRUE  ((BaseType_t)1)
+#define pdFALSE ((BaseType_t)0)
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+#define errQUEUE_FULL  ((BaseType_t)0)
+#define errQUEUE_EMPTY ((BaseType_t)0)
+
+#define portMAX_DELAY ((TickType_t)0xffffffffUL)
+#define portBYTE_ALIGNMENT 8
+
+#define configTICK_RATE_HZ ((TickType_t)1000)
+#define configMAX_PRIORITIES 56
+#define configMINIMAL_STACK_SIZE ((uint16_t)128)
+#define configMAX_TASK_NAME_LEN 16
+#define configSUPPORT_STATIC_ALLOCATION 1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configUSE_TASK_NOTIFICATIONS 1
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY 0
+
+#define portTICK_PERIOD_MS ((TickType_t)1000 / configTICK_RATE_HZ)
+#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(((TickType_t)(xTimeInMs) * configTICK_RATE_HZ) / (TickType_t)1000))
+#define tskIDLE_PRIORITY ((UBaseType_t)0)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void vAssertCalled(const char* pcExpression, const char* pcFile, int ulLine);
+#define configASSERT(x) do { if ((x) == 0) vAssertCalled(#x, __FILE__, __LINE__); } while (0)
+
+void vPortEnterCritical(void);
+void vPortExitCritical(void);
+UBaseType_t uxPortSetInterruptMaskFromISR(void);
+void vPortClearInterruptMaskFromISR(UBaseType_t uxSavedInterruptStatus);
+BaseType_t xPortIsInsideInterrupt(void);
+void vPortYield(void);
+
+void* pvPortMalloc(size_t xSize);
+void vPortFree(void* pv);
+
+/**
+ * @brief Host only: runs handler(arg) on the calling thread as if it were an
+ * interrupt handler, so xPortIsInsideInterrupt() is true inside it.
+ */
+void vPortRunAsInterrupt(void (*handler)(void*), void* arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define taskENTER_CRITICAL() vPortEnterCritical()
+#define taskEXIT_CRITICAL() vPortExitCritical()
+#define taskENTER_CRITICAL_FROM_ISR() uxPortSetInterruptMaskFromISR()
+#define taskEXIT_CRITICAL_FROM_ISR(x) vPortClearInterruptMaskFromISR(x)
+#define portYIELD() vPortYield()
+#define portYIELD_FROM_ISR(x) do { (void)(x); } while (0)
+#define portEND_SWITCHING_ISR(x) portYIELD_FROM_ISR(x)
+#define taskYIELD() portYIELD()
+
+#endif // CSP4CMSIS_HOST_FREERTOS_H
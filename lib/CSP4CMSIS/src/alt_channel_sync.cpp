@@ -1,79 +1,222 @@
 #include "csp/alt_channel_sync.h"
-#include <cstring>
 #include <cstdio>
 
 namespace csp::internal {
 
-AltChanSyncBase::AltChanSyncBase() : 
-    mutex(nullptr), waiting_in_task(nullptr), waiting_out_task(nullptr),
-    non_alt_in_data_ptr(nullptr), non_alt_out_data_ptr(nullptr) 
-{
-    mutex = xSemaphoreCreateMutex();
+void AltChanSyncBase::transfer(void* dest, const void* src, bool movable) const {
+    if (dest == nullptr || src == nullptr) return;
+    if (movable) payload->move(dest, const_cast<void*>(src));
+    else payload->copy(dest, src);
 }
 
-AltChanSyncBase::~AltChanSyncBase() {
-    if (mutex != nullptr) vSemaphoreDelete(mutex);
-}
-
-bool AltChanSyncBase::tryHandshake(void* data_ptr, size_t size, bool is_writer) {
+// Only a partner blocked in input()/output() has committed. A partner in an ALT may
+// still select another guard, so it is woken instead and completes in activate().
+bool AltChanSyncBase::tryHandshake(void* data_ptr, bool is_writer, bool movable) {
     if (is_writer) {
         // 1. Check for a standard blocking receiver
         if (waiting_in_task != nullptr) {
-            if (non_alt_in_data_ptr && data_ptr) memcpy(non_alt_in_data_ptr, data_ptr, size);
+            transfer(non_alt_in_data_ptr, data_ptr, movable);
             TaskHandle_t t = waiting_in_task;
             clearWaitingIn();
             xTaskNotifyGive(t);
+            endBoost();
             return true; 
         }
-        // 2. Check for a receiver waiting in an ALT
-        if (waiting_in_alt.alt_ptr != nullptr) {
-            if (waiting_in_alt.data_ptr && data_ptr) memcpy(waiting_in_alt.data_ptr, data_ptr, size);
-            // Note: We don't notify here; the Producer's output() call will call wakeUp()
-            return true;
-        }
     } else {
         // 1. Check for a standard blocking sender
         if (waiting_out_task != nullptr) {
-            if (data_ptr && non_alt_out_data_ptr) memcpy(data_ptr, non_alt_out_data_ptr, size);
+            transfer(data_ptr, non_alt_out_data_ptr, out_movable);
             TaskHandle_t t = waiting_out_task;
             clearWaitingOut();
             xTaskNotifyGive(t);
-            return true;
-        }
-        // 2. Check for a sender waiting in an ALT
-        if (waiting_out_alt.alt_ptr != nullptr) {
-            if (data_ptr && waiting_out_alt.data_ptr) memcpy(data_ptr, waiting_out_alt.data_ptr, size);
+            endBoost();
             return true;
         }
     }
     return false;
 }
 
-void AltChanSyncBase::registerWaitingTask(void* data_ptr, bool is_writer) {
+void AltChanSyncBase::registerWaitingTask(void* data_ptr, bool is_writer, bool movable) {
+    endBoost();   // left over if an ISR took the last waiter off
     if (is_writer) {
         waiting_out_task = xTaskGetCurrentTaskHandle();
         non_alt_out_data_ptr = data_ptr;
+        out_movable = movable;
     } else {
         waiting_in_task = xTaskGetCurrentTaskHandle();
         non_alt_in_data_ptr = data_ptr;
     }
 }
 
+// Called without the mutex by a task whose timed input/output expired while registered.
+// A partner that has already taken the task off the channel has committed to the transfer
+// and notifies it. An ALT that is enabled on the other side can still select this task,
+// so the task only withdraws once that ALT has resolved.
+bool AltChanSyncBase::withdraw(bool is_writer) {
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    while (true) {
+        if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return false;
+
+        bool registered = is_writer ? (waiting_out_task == self) : (waiting_in_task == self);
+        if (!registered) {
+            xSemaphoreGive(mutex.get());
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            return true;
+        }
+
+        bool alt_pending = is_writer ? (waiting_in_alt.alt_ptr != nullptr) : (waiting_out_alt.alt_ptr != nullptr);
+        if (!alt_pending) {
+            if (is_writer) clearWaitingOut();
+            else clearWaitingIn();
+            endBoost();
+            xSemaphoreGive(mutex.get());
+            return false;
+        }
+
+        xSemaphoreGive(mutex.get());
+        if (ulTaskNotifyTake(pdTRUE, 1) != 0) return true;
+    }
+}
+
+// --- Priority Inheritance ---
+namespace {
+
+// A task running on inherited priority. Its boosts may come from several
+// channels and end in any order; the task returns to base when the last one ends.
+struct BoostRecord {
+    TaskHandle_t task;       // nullptr: free
+    UBaseType_t base;        // priority to return to
+    UBaseType_t boosted;     // priority the boosts last set
+    UBaseType_t count;       // boosts still active
+};
+
+BoostRecord boost_records[CSP_MAX_BOOSTED_TASKS];
+
+// Called in a critical section. With allocate, a free record is taken if the task has none.
+BoostRecord* findBoost(TaskHandle_t task, bool allocate) {
+    BoostRecord* free_record = nullptr;
+    for (BoostRecord& r : boost_records) {
+        if (r.task == task) return &r;
+        if (r.task == nullptr && free_record == nullptr) free_record = &r;
+    }
+    if (!allocate || free_record == nullptr) return nullptr;
+    free_record->task = task;
+    free_record->count = 0;
+    return free_record;
+}
+
+} // namespace
+
+// Called with the mutex held, by a task that has just registered as waiting. The
+// boost lasts until the task is taken off the channel (endBoost()). A partner that
+// already runs on a boost from another channel counts this one too, so it is not
+// dropped while this channel still waits on it.
+void AltChanSyncBase::boostPartner(bool is_writer) {
+    if (!inherit_priority) return;
+    TaskHandle_t partner = is_writer ? last_reader : last_writer;
+    if (partner == nullptr || partner == boosted_task) return;
+
+    UBaseType_t mine = uxTaskPriorityGet(nullptr);
+    bool full = false;
+
+    taskENTER_CRITICAL();
+    UBaseType_t theirs = uxTaskPriorityGet(partner);
+    BoostRecord* r = findBoost(partner, theirs < mine);
+    if (r != nullptr) {
+        // First boost, or the priority was set elsewhere meanwhile: that is the base now
+        if (r->count == 0 || theirs != r->boosted) {
+            r->base = theirs;
+            r->boosted = theirs;
+        }
+        r->count++;
+        if (theirs < mine) {
+            r->boosted = mine;
+            vTaskPrioritySet(partner, mine);
+        }
+        boosted_task = partner;
+    } else {
+        full = theirs < mine;
+    }
+    taskEXIT_CRITICAL();
+
+    if (full) {
+        printf("CSP ERROR: More tasks on inherited priority than CSP_MAX_BOOSTED_TASKS.\r\n");
+        configASSERT(pdFALSE);
+        return;
+    }
+    if (theirs < mine && mine - theirs > max_boost) max_boost = mine - theirs;
+}
+
+// Called with the mutex held. The partner's priority is only restored by its last
+// boost, and only if nothing else has changed it since.
+void AltChanSyncBase::endBoost() {
+    if (boosted_task == nullptr) return;
+
+    taskENTER_CRITICAL();
+    BoostRecord* r = findBoost(boosted_task, false);
+    if (r != nullptr && --r->count == 0) {
+        if (uxTaskPriorityGet(boosted_task) == r->boosted) vTaskPrioritySet(boosted_task, r->base);
+        r->task = nullptr;
+    }
+    taskEXIT_CRITICAL();
+
+    boosted_task = nullptr;
+}
+
+// --- Extended Rendezvous ---
+// Called with the mutex held. The reader blocks without a destination buffer.
+void AltChanSyncBase::registerExtReader() {
+    endBoost();
+    waiting_in_task = xTaskGetCurrentTaskHandle();
+    non_alt_in_data_ptr = nullptr;
+    ext_in_waiting = true;
+}
+
+// Called with the mutex held by a writer that found an extended reader. The writer
+// lends its buffer and wakes the reader; it must then block until
+// releaseExtWriter() is called.
+void AltChanSyncBase::lendToExtReader(const void* data_ptr) {
+    TaskHandle_t reader = waiting_in_task;
+    clearWaitingIn();
+    ext_writer = xTaskGetCurrentTaskHandle();
+    ext_data_ptr = data_ptr;
+    xTaskNotifyGive(reader);
+    endBoost();
+}
+
+// Called with the mutex held by an extended reader that found a writer parked in
+// output(). The writer is committed from here on: withdraw() no longer finds it
+// registered, so it waits for releaseExtWriter() even if its timeout expires.
+// Any boost it lent the reader lasts until then.
+const void* AltChanSyncBase::borrowFromWriter() {
+    ext_writer = waiting_out_task;
+    ext_data_ptr = non_alt_out_data_ptr;
+    clearWaitingOut();
+    return ext_data_ptr;
+}
+
+// Called with the mutex held by the reader once it has finished with the writer's data.
+void AltChanSyncBase::releaseExtWriter() {
+    TaskHandle_t writer = ext_writer;
+    ext_writer = nullptr;
+    ext_data_ptr = nullptr;
+    if (writer != nullptr) xTaskNotifyGive(writer);
+    endBoost();
+}
+
 // --- ChanInGuard Implementation ---
 bool ChanInGuard::enable(AltScheduler* alt, EventBits_t bit) {
     if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
 
-    // Check if a sender is already waiting (Standard output() call)
-    if (parent_channel->getWaitingOutTask() != nullptr) {
-        xSemaphoreGive(parent_channel->getMutex());
-        return true; 
-    }
+    // Register our AltScheduler for wake-up. This is done even when a sender is
+    // already waiting, so that a timed sender does not withdraw under our feet.
+    parent_channel->getWaitingInAlt().set(alt, bit, user_data_dest);
 
-    // Register our AltScheduler for wake-up
-    parent_channel->getWaitingInAlt().set(alt, bit, user_data_dest, data_size);
+    // Check if a sender is already waiting (Standard output() call)
+    bool ready = (parent_channel->getWaitingOutTask() != nullptr);
     
     xSemaphoreGive(parent_channel->getMutex());
-    return false;
+    return ready;
 }
 
 void ChanInGuard::activate() {
@@ -81,13 +224,15 @@ void ChanInGuard::activate() {
     
     TaskHandle_t sender = parent_channel->getWaitingOutTask();
     if (sender != nullptr) {
-        if (user_data_dest && parent_channel->getNonAltOutDataPtr()) 
-            memcpy(user_data_dest, parent_channel->getNonAltOutDataPtr(), data_size);
+        parent_channel->transfer(user_data_dest, parent_channel->getNonAltOutDataPtr(),
+                                 parent_channel->isNonAltOutMovable());
         parent_channel->clearWaitingOut();
-        xSemaphoreGive(parent_channel->getMutex());
+        // Any boost this process got ends once the blocked sender can run
         xTaskNotifyGive(sender);
+        parent_channel->endBoost();
+        xSemaphoreGive(parent_channel->getMutex());
     } else {
-        // Data was already copied during tryHandshake in output()
+        // No committed sender (it withdrew after a timeout): nothing to take
         xSemaphoreGive(parent_channel->getMutex());
     }
 }
@@ -100,31 +245,51 @@ bool ChanInGuard::disable() {
     return was_ready;
 }
 
+// --- ChanInPendingGuard Implementation ---
+bool ChanInPendingGuard::enable(AltScheduler* alt, EventBits_t bit) {
+    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
+    parent_channel->getWaitingInAlt().set(alt, bit, nullptr);
+    bool ready = (parent_channel->getWaitingOutTask() != nullptr);
+    xSemaphoreGive(parent_channel->getMutex());
+    return ready;
+}
+
+bool ChanInPendingGuard::disable() {
+    if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
+    bool was_ready = (parent_channel->getWaitingOutTask() != nullptr);
+    parent_channel->getWaitingInAlt().clear();
+    xSemaphoreGive(parent_channel->getMutex());
+    return was_ready;
+}
+
 // --- ChanOutGuard Implementation ---
 bool ChanOutGuard::enable(AltScheduler* alt, EventBits_t bit) {
     if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return false;
 
-    if (parent_channel->getWaitingInTask() != nullptr) {
-        xSemaphoreGive(parent_channel->getMutex());
-        return true;
-    }
+    // Registered even when ready, so that a timed receiver does not withdraw under our feet
+    parent_channel->getWaitingOutAlt().set(alt, bit, const_cast<void*>(user_data_source));
 
-    parent_channel->getWaitingOutAlt().set(alt, bit, const_cast<void*>(user_data_source), data_size);
+    bool ready = (parent_channel->getWaitingInTask() != nullptr);
     
     xSemaphoreGive(parent_channel->getMutex());
-    return false;
+    return ready;
 }
 
 void ChanOutGuard::activate() {
     if (xSemaphoreTake(parent_channel->getMutex(), portMAX_DELAY) != pdTRUE) return;
     
     TaskHandle_t receiver = parent_channel->getWaitingInTask();
-    if (receiver != nullptr) {
-        if (parent_channel->getNonAltInDataPtr() && user_data_source)
-            memcpy(parent_channel->getNonAltInDataPtr(), user_data_source, data_size);
-        parent_channel->clearWaitingIn();
+    if (receiver != nullptr && parent_channel->isExtReaderWaiting()) {
+        // Extended reader: lend our buffer and stay blocked until it is done with it
+        parent_channel->lendToExtReader(user_data_source);
         xSemaphoreGive(parent_channel->getMutex());
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    } else if (receiver != nullptr) {
+        parent_channel->transfer(parent_channel->getNonAltInDataPtr(), user_data_source, false);
+        parent_channel->clearWaitingIn();
         xTaskNotifyGive(receiver);
+        parent_channel->endBoost();
+        xSemaphoreGive(parent_channel->getMutex());
     } else {
         xSemaphoreGive(parent_channel->getMutex());
     }
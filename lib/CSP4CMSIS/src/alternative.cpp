@@ -3,21 +3,30 @@
 
 namespace csp::internal {
 
+// Wrap-safe tick comparison: a is at or after b if less than half the tick range separates them.
+static bool atOrAfter(TickType_t a, TickType_t b) {
+    return (TickType_t)(a - b) < ((TickType_t)1 << (sizeof(TickType_t) * 8 - 1));
+}
+
 // =============================================================
 // AltScheduler Implementation
 // =============================================================
-AltScheduler::AltScheduler() { 
-    initForCurrentTask(); 
+void AltScheduler::bindToCurrentTask() {
+    waiting_task_handle = xTaskGetCurrentTaskHandle();
 }
 
-AltScheduler::~AltScheduler() { 
-    if (event_group) vEventGroupDelete(event_group); 
-}
+// Sleeps until a guard in mask has fired or block ticks have passed.
+void AltScheduler::wait(uint32_t mask, TickType_t block) {
+    wait_state.store(WAITING);
+    // Pairs with wakeUp(): either it sees WAITING, or the bit it set is seen here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
 
-void AltScheduler::initForCurrentTask() {
-    waiting_task_handle = xTaskGetCurrentTaskHandle();
-    // Using standard FreeRTOS event group creation
-    event_group = xEventGroupCreate();
+    bool notified = (fired.load() & mask) == 0 && ulTaskNotifyTake(pdTRUE, block) != 0;
+    if (!notified && wait_state.exchange(IDLE) == NOTIFIED) {
+        // A guard fired as we stopped waiting: its notification is on its way
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    wait_state.store(IDLE);
 }
 
 unsigned int AltScheduler::select(Guard** guardArray, size_t amount, size_t offset) {
@@ -26,47 +35,80 @@ unsigned int AltScheduler::select(Guard** guardArray, size_t amount, size_t offs
     const char* tname = pcTaskGetName(NULL);
     // printf("[%s] ALT: select start (guards: %u, offset: %u)\r\n", tname, amount, offset);
 
-    EventBits_t wait_mask = 0;
+    uint32_t wait_mask = 0;
     for(size_t i = 0; i < amount; ++i) wait_mask |= (1 << i);
+
+    bindToCurrentTask();
+    select_start = xTaskGetTickCount();
     
-    xEventGroupClearBits(event_group, wait_mask); 
-
-    int ready_idx = -1;
-    // Phase 1: Enable
-    for(size_t i = 0; i < amount; ++i) {
-        size_t idx = (i + offset) % amount; 
-        // printf("[%s] ALT: Enabling guard %u...\r\n", tname, idx);
-        
-        if(guardArray[idx]->enable(this, (1 << idx))) { 
-            // printf("[%s] ALT: Guard %u was ALREADY ready.\r\n", tname, idx);
-            ready_idx = (int)idx; 
-            break; 
+    size_t selected = 0;
+    while (true) {
+        fired.fetch_and(~wait_mask);
+
+        int ready_idx = -1;
+        // Phase 1: Enable
+        for(size_t i = 0; i < amount; ++i) {
+            size_t idx = (i + offset) % amount; 
+            // printf("[%s] ALT: Enabling guard %u...\r\n", tname, idx);
+            
+            if(guardArray[idx]->enable(this, (1 << idx))) { 
+                // printf("[%s] ALT: Guard %u was ALREADY ready.\r\n", tname, idx);
+                ready_idx = (int)idx; 
+                break; 
+            }
         }
-    }
 
-    // Phase 2: Wait
-    EventBits_t fired = 0;
-    if (ready_idx != -1) {
-        fired = (1 << ready_idx);
-    } else {
-        // printf("[%s] ALT: No guard ready. Sleeping on event group...\r\n", tname);
-        fired = xEventGroupWaitBits(event_group, wait_mask, pdTRUE, pdFALSE, portMAX_DELAY);
-        // printf("[%s] ALT: Woke up! Fired bits: 0x%lx\r\n", tname, fired);
-    }
+        // Phase 2: Wait
+        uint32_t fired_bits = 0;
+        if (ready_idx != -1) {
+            fired_bits = (1 << ready_idx);
+        } else {
+            // The earliest timeout bounds the wait; no guard runs a timer of its own
+            size_t timeout_idx = amount;
+            TickType_t earliest = 0;
+            for(size_t i = 0; i < amount; ++i) {
+                TickType_t at;
+                if (guardArray[i]->deadline(&at) && (timeout_idx == amount || !atOrAfter(at, earliest))) {
+                    earliest = at;
+                    timeout_idx = i;
+                }
+            }
 
-    // Identify which guard fired
-    size_t selected = 0;
-    for(size_t i = 0; i < amount; ++i) {
-        if (fired & (1 << i)) { 
-            selected = i; 
-            break; 
+            TickType_t block = portMAX_DELAY;
+            if (timeout_idx != amount) {
+                TickType_t now = xTaskGetTickCount();
+                block = atOrAfter(now, earliest) ? 0 : (TickType_t)(earliest - now);
+            }
+
+            // printf("[%s] ALT: No guard ready. Sleeping...\r\n", tname);
+            wait(wait_mask, block);
+            fired_bits = fired.load() & wait_mask;
+            // printf("[%s] ALT: Woke up! Fired bits: 0x%lx\r\n", tname, fired_bits);
+
+            if (fired_bits == 0 && timeout_idx != amount) fired_bits = (1 << timeout_idx);
+        }
+
+        // Identify which guard fired
+        for(size_t i = 0; i < amount; ++i) {
+            if (fired_bits & (1 << i)) { 
+                selected = i; 
+                break; 
+            }
         }
-    }
 
-    // Phase 3: Disable
-    // printf("[%s] ALT: Disabling all guards.\r\n", tname);
-    for(size_t i = 0; i < amount; ++i) {
-        guardArray[i]->disable();
+        // Phase 3: Disable
+        // printf("[%s] ALT: Disabling all guards.\r\n", tname);
+        bool selected_ready = true;
+        for(size_t i = 0; i < amount; ++i) {
+            bool ready = guardArray[i]->disable();
+            if (i == selected) selected_ready = ready;
+        }
+
+        // A channel can set a guard's bit after the event it announced was taken
+        // by an earlier select (the bit outlives the select that enabled it). The
+        // woken guard then reports nothing ready: wait again. Relative timeouts
+        // keep counting from select_start.
+        if (ready_idx != -1 || selected_ready) break;
     }
 
     // Phase 4: Activate
@@ -76,50 +118,160 @@ unsigned int AltScheduler::select(Guard** guardArray, size_t amount, size_t offs
     return (unsigned int)selected;
 }
 
+// Takes (clears) the first set bit at or after `from`, wrapping round; -1 if none.
+static int takeReady(std::atomic<uint32_t>* words, size_t amount, size_t from) {
+    const size_t nwords = (amount + 31) / 32;
+    for (size_t k = 0; k <= nwords; ++k) {
+        size_t w = (from / 32 + k) % nwords;
+        uint32_t bits = words[w].load(std::memory_order_acquire);
+        if (k == 0) bits &= ~0u << (from % 32);                 // from `from` on
+        else if (k == nwords) bits &= ~(~0u << (from % 32));    // wrapped back to below it
+        while (bits != 0) {
+            uint32_t bit = 1u << __builtin_ctz(bits);
+            if (words[w].fetch_and(~bit) & bit) return (int)(w * 32 + __builtin_ctz(bit));
+            bits &= ~bit;
+        }
+    }
+    return -1;
+}
+
+unsigned int AltScheduler::selectPersistent(Guard** guardArray, size_t amount,
+                                            const uint32_t* timeout_mask, size_t offset) {
+    if (amount == 0) return 0;
+    const size_t nwords = (amount + 31) / 32;
+
+    bindToCurrentTask();
+    select_start = xTaskGetTickCount();
+
+    while (true) {
+        // A wake-up after this point leaves the bit set, so the wait below returns at once
+        fired.store(0);
+
+        // Timeout guards are re-armed on every select; they take no channel lock
+        for (size_t w = 0; w < nwords; ++w) {
+            if (timeout_mask[w]) ready_words[w].fetch_or(timeout_mask[w]);
+        }
+
+        // Ask only the guards that signalled. One that is not ready after all has
+        // been registered again by enable(), and its channel sets the bit again.
+        int chosen;
+        while ((chosen = takeReady(ready_words, amount, offset)) >= 0) {
+            if (guardArray[chosen]->enable(this, (EventBits_t)chosen)) break;
+        }
+
+        if (chosen >= 0) {
+            guardArray[chosen]->activate();
+            // It may still be ready (more data buffered): ask it again next time
+            ready_words[chosen / 32].fetch_or(1u << (chosen % 32));
+            return (unsigned int)chosen;
+        }
+
+        TickType_t block = portMAX_DELAY;
+        bool bounded = false;
+        TickType_t earliest = 0;
+        for (size_t w = 0; w < nwords; ++w) {
+            uint32_t bits = timeout_mask[w];
+            while (bits != 0) {
+                size_t i = w * 32 + __builtin_ctz(bits);
+                bits &= bits - 1;
+                TickType_t at;
+                if (guardArray[i]->deadline(&at) && (!bounded || !atOrAfter(at, earliest))) {
+                    earliest = at;
+                    bounded = true;
+                }
+            }
+        }
+        if (bounded) {
+            TickType_t now = xTaskGetTickCount();
+            block = atOrAfter(now, earliest) ? 0 : (TickType_t)(earliest - now);
+        }
+
+        wait(1, block);
+    }
+}
+
 void AltScheduler::wakeUp(EventBits_t bit) {
-    if(!event_group) return;
+    if (ready_words != nullptr) {
+        // Persistent mode: bit is the guard's index, and every guard wakes through bit 0
+        ready_words[bit / 32].fetch_or(1u << (bit % 32));
+        bit = 1;
+    }
     // printf("[%s] ALT: wakeUp called for bit 0x%lx\r\n", pcTaskGetName(NULL), bit);
+    fired.fetch_or((uint32_t)bit);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Only a select that is waiting is notified, and only once
+    uint32_t expected = WAITING;
+    if (!wait_state.compare_exchange_strong(expected, NOTIFIED)) return;
+
     if (xPortIsInsideInterrupt()) {
         BaseType_t woken = pdFALSE;
-        xEventGroupSetBitsFromISR(event_group, bit, &woken);
+        vTaskNotifyGiveFromISR(waiting_task_handle, &woken);
         portYIELD_FROM_ISR(woken);
     } else {
-        xEventGroupSetBits(event_group, bit);
+        xTaskNotifyGive(waiting_task_handle);
     }
 }
 // =============================================================
-// TimerGuard Implementation
+// TimeoutGuard Implementation
 // =============================================================
-TimerGuard::TimerGuard(csp::Time delay) 
-    : parent_alt(nullptr), delay_ticks(delay.to_ticks()), assigned_bit(0) 
-{
-    timer_handle = xTimerCreate("CspTmr", delay_ticks, pdFALSE, this, TimerCallback);
+bool TimeoutGuard::expired() const {
+    return atOrAfter(xTaskGetTickCount(), at);
 }
 
-TimerGuard::~TimerGuard() { 
-    if (timer_handle) xTimerDelete(timer_handle, 0); 
+bool TimeoutGuard::enable(AltScheduler* a, EventBits_t) {
+    at = absolute ? ticks : (TickType_t)(a->selectStart() + ticks);
+    return expired();
 }
 
-void TimerGuard::TimerCallback(TimerHandle_t x) {
-    auto* s = static_cast<TimerGuard*>(pvTimerGetTimerID(x));
-    if(s && s->parent_alt) {
-        s->parent_alt->wakeUp(s->assigned_bit);
-    }
+bool TimeoutGuard::disable() { 
+    return expired(); 
+}
+
+void TimeoutGuard::activate() {}
+
+bool TimeoutGuard::deadline(TickType_t* out) const {
+    *out = at;
+    return true;
 }
 
-bool TimerGuard::enable(AltScheduler* a, EventBits_t b) {
-    parent_alt = a; 
+// =============================================================
+// IrqLineGuard Implementation
+// =============================================================
+void IrqLineGuard::fire() {
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+    if (pending > 0) coalesced = coalesced + 1;
+    pending = pending + 1;
+    AltScheduler* alt = parent_alt;
+    EventBits_t bit = assigned_bit;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    if (alt) alt->wakeUp(bit);
+}
+
+bool IrqLineGuard::enable(AltScheduler* a, EventBits_t b) {
+    taskENTER_CRITICAL();
     assigned_bit = b;
-    xTimerStart(timer_handle, 0);
-    return false; 
+    parent_alt = a;
+    bool ready = pending > 0;
+    taskEXIT_CRITICAL();
+    return ready;
 }
 
-bool TimerGuard::disable() { 
-    if (timer_handle) xTimerStop(timer_handle, 0); 
-    return true; 
+bool IrqLineGuard::disable() {
+    taskENTER_CRITICAL();
+    parent_alt = nullptr;
+    bool ready = pending > 0;
+    taskEXIT_CRITICAL();
+    return ready;
 }
 
-void TimerGuard::activate() {}
+void IrqLineGuard::activate() {
+    taskENTER_CRITICAL();
+    taken = pending;
+    pending = 0;
+    taskEXIT_CRITICAL();
+}
 
 } // namespace csp::internal
 
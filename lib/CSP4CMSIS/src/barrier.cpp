@@ -3,6 +3,7 @@
 #include "csp/barrier.h" // Barrier definition
 #include "FreeRTOS.h"
 #include "semphr.h"
+#include "event_groups.h"
 #include <cstdio>
 
 namespace csp::internal {
@@ -11,76 +12,188 @@ namespace csp::internal {
 //  Barrier Implementation
 // =============================================================
 
+void Barrier::completePhase() {
+    uint32_t done = phases;
+    arrived = 0;
+    phases = done + 1;
+
+    // Nobody can reach the next phase before the SetBits below releases them,
+    // so its bit is cleared in time; every waiter of this phase leaves in one call.
+    xEventGroupClearBits(xReleased.get(), phaseBit(done + 1));
+    xEventGroupSetBits(xReleased.get(), phaseBit(done));
+
+    wakeAltIfReady();
+}
+
+void Barrier::wakeAltIfReady() {
+    if (alt != nullptr && othersWaiting()) alt->wakeUp(alt_bit);
+}
+
 /**
- * @brief Constructs a reusable barrier for N processes.
- * @param N The maximum number of processes required to synchronize.
+ * @brief Blocks the calling task until all enrolled processes have reached the barrier.
  */
-Barrier::Barrier(size_t N) 
-    // The barrier needs N arrivals (max_processes)
-    : max_processes(N), count(0)
-{
-    // Create the Mutex to protect the shared counter
-    xCountMutex = xSemaphoreCreateMutex();
-    
-    // Create the Semaphore used for blocking and release.
-    // Initial count is 0 (all tasks block). Max count is N (allows N tasks to be released).
-    xWaitSemaphore = xSemaphoreCreateCounting(N, 0); 
-
-    if (xCountMutex == nullptr || xWaitSemaphore == nullptr) {
-        printf("ERROR: Barrier synchronization object creation failed!\r\n");
+void Barrier::sync() {
+    xSemaphoreTake(xCountMutex.get(), portMAX_DELAY);
+
+    if (enrolled == 0) {
+        xSemaphoreGive(xCountMutex.get());
+        printf("CSP ERROR: Barrier::sync() with no process enrolled.\r\n");
+        configASSERT(pdFALSE);
+        return;
+    }
+
+    uint32_t my_phase = phases;
+    arrived++;
+
+    if (arrived == enrolled) {
+        // Last one in: release everyone waiting in this phase
+        completePhase();
+        xSemaphoreGive(xCountMutex.get());
+        return;
     }
+
+    wakeAltIfReady();
+    xSemaphoreGive(xCountMutex.get());
+
+    xEventGroupWaitBits(xReleased.get(), phaseBit(my_phase), pdFALSE, pdFALSE, portMAX_DELAY);
+}
+
+void Barrier::enroll() {
+    xSemaphoreTake(xCountMutex.get(), portMAX_DELAY);
+    enrolled++;
+    xSemaphoreGive(xCountMutex.get());
 }
 
-Barrier::~Barrier() {
-    // 1. Check and delete the counting semaphore used for blocking/releasing
-    if (xWaitSemaphore) { 
-        vSemaphoreDelete(xWaitSemaphore);
+void Barrier::resign() {
+    xSemaphoreTake(xCountMutex.get(), portMAX_DELAY);
+    configASSERT(enrolled > arrived);
+    enrolled--;
+    if (arrived > 0 && arrived == enrolled) {
+        completePhase();
+    } else {
+        wakeAltIfReady();
     }
-    // 2. Check and delete the mutex used for protecting the count variable
-    if (xCountMutex) { 
-        vSemaphoreDelete(xCountMutex);
+    xSemaphoreGive(xCountMutex.get());
+}
+
+bool BarrierAltGuard::enable(AltScheduler* a, EventBits_t bit) {
+    xSemaphoreTake(barrier->xCountMutex.get(), portMAX_DELAY);
+    if (barrier->alt_guard != nullptr && barrier->alt_guard != this) {
+        xSemaphoreGive(barrier->xCountMutex.get());
+        printf("CSP ERROR: Only one process at a time can sync on a Barrier in an ALT.\r\n");
+        configASSERT(pdFALSE);
+        return false;
     }
+    barrier->alt = a;
+    barrier->alt_bit = bit;
+    barrier->alt_guard = this;
+    bool ready = barrier->othersWaiting();
+    xSemaphoreGive(barrier->xCountMutex.get());
+    return ready;
 }
 
-/**
- * @brief Blocks the calling task until all N processes have reached the barrier.
- */
-void Barrier::sync() {
-    // 1. Acquire the mutex to safely update the count
-    xSemaphoreTake(xCountMutex, portMAX_DELAY);
-    
-    // Increment the arrival count
-    count++;
-    
-    bool last_arrival = (count == max_processes);
-    
-    // Release the mutex
-    xSemaphoreGive(xCountMutex);
-    
-    if (last_arrival) {
-        // Last one in: Release all waiting tasks and reset the barrier.
-        
-        // Release N tasks
-        for (size_t i = 0; i < max_processes; ++i) {
-            // Give the semaphore N times to unblock all tasks blocked on xSemaphoreTake
-            xSemaphoreGive(xWaitSemaphore); 
+bool BarrierAltGuard::disable() {
+    xSemaphoreTake(barrier->xCountMutex.get(), portMAX_DELAY);
+    if (barrier->alt_guard == this) {
+        barrier->alt = nullptr;
+        barrier->alt_guard = nullptr;
+    }
+    bool ready = barrier->othersWaiting();
+    xSemaphoreGive(barrier->xCountMutex.get());
+    return ready;
+}
+
+// Everyone else is waiting, so this sync is the last arrival and does not block
+void BarrierAltGuard::activate() {
+    barrier->sync();
+}
+
+// =============================================================
+//  Bucket Implementation
+// =============================================================
+
+void Bucket::fallInto() {
+    xSemaphoreTake(xMutex.get(), portMAX_DELAY);
+    size_t my_slot = slot;
+    held++;
+    slot_waiters[my_slot]++;
+    xSemaphoreGive(xMutex.get());
+
+    xEventGroupWaitBits(xReleased.get(), slotBit(my_slot), pdFALSE, pdFALSE, portMAX_DELAY);
+
+    xSemaphoreTake(xMutex.get(), portMAX_DELAY);
+    slot_waiters[my_slot]--;
+    xSemaphoreGive(xMutex.get());
+}
+
+size_t Bucket::flush() {
+    xSemaphoreTake(xMutex.get(), portMAX_DELAY);
+
+    // The next fill needs a bit that no task released earlier is still waiting on
+    size_t next = slot;
+    for (size_t i = 1; i < FLUSH_SLOTS; ++i) {
+        size_t candidate = (slot + i) % FLUSH_SLOTS;
+        if (slot_waiters[candidate] == 0) {
+            next = candidate;
+            break;
         }
-        
-        // Reset the counter for the next phase
-        // NOTE: No mutex needed here as no other task is competing for the count yet.
-        count = 0; 
-        
-    } else {
-        // Not the last one in: Block and wait for the last arrival to release us.
-        
-        // Block until the xWaitSemaphore is available (given by the last arrival).
-        // portMAX_DELAY ensures we wait indefinitely.
-        xSemaphoreTake(xWaitSemaphore, portMAX_DELAY); 
     }
+    if (next == slot) {
+        xSemaphoreGive(xMutex.get());
+        printf("CSP ERROR: Bucket flushed more often than its released processes could leave.\r\n");
+        configASSERT(pdFALSE);
+        return 0;
+    }
+
+    size_t released = held;
+    held = 0;
+    flushes = flushes + 1;
+
+    // One broadcast releases everyone blocked in fallInto()
+    xEventGroupClearBits(xReleased.get(), slotBit(next));
+    xEventGroupSetBits(xReleased.get(), slotBit(slot));
+    slot = next;
+    for (size_t i = 0; i < num_alts; ++i) {
+        alts[i].guard->inside = false;
+        alts[i].alt->wakeUp(alts[i].bit);
+    }
+    num_alts = 0;
+    xSemaphoreGive(xMutex.get());
+    return released;
 }
 
-// Add the default destructor implementation if necessary to make the class concrete
-// (Note: Already defined in the constructor/destructor block above)
+bool BucketAltGuard::enable(AltScheduler* a, EventBits_t bit) {
+    xSemaphoreTake(bucket->xMutex.get(), portMAX_DELAY);
+    if (bucket->num_alts == Bucket::MAX_ALTS) {
+        xSemaphoreGive(bucket->xMutex.get());
+        printf("CSP ERROR: More ALTs wait in a Bucket than it has room for.\r\n");
+        configASSERT(pdFALSE);
+        return false;
+    }
+    bucket->alts[bucket->num_alts++] = Bucket::AltWaiter{ a, bit, this };
+    bucket->held++;
+    entered_at = bucket->flushes;
+    inside = true;
+    xSemaphoreGive(bucket->xMutex.get());
+    return false;
+}
 
-} // namespace csp::internal
+bool BucketAltGuard::disable() {
+    xSemaphoreTake(bucket->xMutex.get(), portMAX_DELAY);
+    if (inside) {
+        // Not flushed: climb back out
+        for (size_t i = 0; i < bucket->num_alts; ++i) {
+            if (bucket->alts[i].guard == this) {
+                bucket->alts[i] = bucket->alts[--bucket->num_alts];
+                break;
+            }
+        }
+        bucket->held--;
+        inside = false;
+    }
+    bool flushed = bucket->flushes != entered_at;
+    xSemaphoreGive(bucket->xMutex.get());
+    return flushed;
+}
 
+} // namespace csp::internal
@@ -0,0 +1,97 @@
+// --- coro.cpp ---
+
+#include "csp/coro.h"
+
+#if CSP_HAS_COROUTINES
+
+#include <cstdio>
+
+namespace csp::coro {
+
+namespace internal {
+
+namespace {
+    alignas(8) unsigned char arena[CSP_CORO_ARENA_BYTES];
+    size_t arena_used = 0;
+    size_t frames_live = 0;
+}
+
+void* frame_alloc(size_t size) noexcept {
+    const size_t rounded = (size + 7u) & ~size_t(7u);
+    void* frame = nullptr;
+
+    taskENTER_CRITICAL();
+    if (rounded <= sizeof(arena) - arena_used) {
+        frame = &arena[arena_used];
+        arena_used += rounded;
+        frames_live++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (frame == nullptr) {
+        printf("CSP ERROR: coroutine arena exhausted (%u bytes), raise CSP_CORO_ARENA_BYTES.\r\n",
+               (unsigned)sizeof(arena));
+    }
+    return frame;
+}
+
+void frame_free(void* frame) noexcept {
+    if (frame == nullptr) return;
+
+    taskENTER_CRITICAL();
+    if (--frames_live == 0) {
+        arena_used = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+} // namespace internal
+
+// =============================================================
+//  Executor Implementation
+// =============================================================
+
+void Executor::spawn(Process&& process) {
+    Process::Handle h = process.release();
+    if (!h) return; // frame allocation failed, already reported
+
+    if (live == capacity) {
+        printf("CSP ERROR: coroutine group is full (%u processes).\r\n", (unsigned)capacity);
+        h.destroy();
+        return;
+    }
+
+    h.promise().executor = this;
+    live++;
+    schedule(h);
+}
+
+void Executor::schedule(Process::Handle h) {
+    configASSERT(count < capacity);
+    ring[(head + count) % capacity] = h;
+    count++;
+}
+
+size_t Executor::drive() {
+    while (count > 0) {
+        Process::Handle h = ring[head];
+        head = (head + 1) % capacity;
+        count--;
+
+        h.resume();
+
+        if (h.done()) {
+            h.destroy();
+            live--;
+        }
+    }
+
+    if (live > 0) {
+        printf("CSP ERROR: coroutine group stopped with %u processes blocked.\r\n", (unsigned)live);
+    }
+    return live;
+}
+
+} // namespace csp::coro
+
+#endif // CSP_HAS_COROUTINES
@@ -13,15 +13,14 @@ extern "C" {
         // 1. Run the process logic 
         ctx->process->run();
         
-        // 2. Signal completion
+        // 2. Signal completion. The TCB and stack are static slots owned by the
+        //    network; the joining task deletes this task before reusing them.
         if (ctx->completion_sem) {
             xSemaphoreGive(ctx->completion_sem);
+            vTaskSuspend(NULL);
         }
         
-        // 3. Clean up generic wrapper info
-        delete ctx;
-        
-        // 4. Delete this FreeRTOS task
+        // 3. Delete this FreeRTOS task (perpetual network process that returned)
         vTaskDelete(NULL);
     }
 }
@@ -11,29 +11,6 @@ namespace csp::internal {
 // SyncChannel Core Implementation
 // =============================================================
 
-SyncChannel::SyncChannel()
-    : mutex(xSemaphoreCreateMutex()),
-      state(IDLE),
-      data_ptr(nullptr),
-      data_len(0),
-      waiting_alt_in(nullptr),
-      waiting_alt_bit_in(0),
-      waiting_guard_in(nullptr),
-      waiting_alt_out(nullptr),
-      waiting_alt_bit_out(0),
-      waiting_guard_out(nullptr),
-      sender_queue(xQueueCreate(1, 0)),
-      receiver_queue(xQueueCreate(1, 0)),
-      res_in_guard(this),  
-      res_out_guard(this)  
-{}
-
-SyncChannel::~SyncChannel() {
-    if (mutex) vSemaphoreDelete(mutex);
-    if (sender_queue) vQueueDelete(sender_queue);
-    if (receiver_queue) vQueueDelete(receiver_queue);
-}
-
 void SyncChannel::reset() {
     state = IDLE;
     data_ptr = nullptr;
@@ -48,7 +25,7 @@ void SyncChannel::reset() {
 
 // --- Blocking Output (Sender) ---
 void SyncChannel::output(const void* const data_ptr_in) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return;
+    if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return;
 
     if (state == RECEIVER_WAITING) {
         // A receiver is already waiting (either blocking or in an ALT)
@@ -59,33 +36,33 @@ void SyncChannel::output(const void* const data_ptr_in) {
         bool is_alt_waiter = (waiting_alt_in != nullptr);
 
         waiting_alt_in = nullptr; 
-        xSemaphoreGive(mutex);
+        xSemaphoreGive(mutex.get());
 
         if (is_alt_waiter) {
             // Wake up the Alternative selection loop
-            xEventGroupSetBits(rx_alt->getEventGroupHandle(), rx_alt_bit);
+            rx_alt->wakeUp(rx_alt_bit);
         } else {
             // Wake up a blocking input() call
-            xQueueSend(receiver_queue, nullptr, 0);
+            xQueueSend(receiver_queue.get(), nullptr, 0);
         }
 
         // BLOCK: Wait for the Receiver to finish copying data and acknowledge
-        while (xQueueReceive(sender_queue, nullptr, WAIT_SLICE_TICKS) != pdPASS);
+        while (xQueueReceive(sender_queue.get(), nullptr, WAIT_SLICE_TICKS) != pdPASS);
     }
     else {
         // No receiver present, wait here as the primary sender
         state = SENDER_WAITING;
         data_ptr = data_ptr_in;
-        xSemaphoreGive(mutex);
+        xSemaphoreGive(mutex.get());
         
         // Wait until a receiver arrives and signals this queue
-        while (xQueueReceive(sender_queue, nullptr, WAIT_SLICE_TICKS) != pdPASS);
+        while (xQueueReceive(sender_queue.get(), nullptr, WAIT_SLICE_TICKS) != pdPASS);
     }
 }
 
 // --- Blocking Input (Receiver) ---
 void SyncChannel::input(void* const data_ptr_out) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return;
+    if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return;
 
     if (state == SENDER_WAITING) {
         // Sender is already waiting; perform immediate transfer
@@ -100,32 +77,66 @@ void SyncChannel::input(void* const data_ptr_out) {
         waiting_alt_out = nullptr; 
 
         if (is_alt_waiter) {
-            xEventGroupSetBits(tx_alt->getEventGroupHandle(), tx_alt_bit);
+            tx_alt->wakeUp(tx_alt_bit);
         } else {
             // Release the blocking sender
-            xQueueSend(sender_queue, nullptr, 0);
+            xQueueSend(sender_queue.get(), nullptr, 0);
         }
         
         reset(); 
-        xSemaphoreGive(mutex);
+        xSemaphoreGive(mutex.get());
     }
     else {
         // No sender present, register as the waiting receiver
         state = RECEIVER_WAITING;
-        xSemaphoreGive(mutex);
+        xSemaphoreGive(mutex.get());
 
         // Wait for a sender to signal the receiver_queue
-        while (xQueueReceive(receiver_queue, nullptr, WAIT_SLICE_TICKS) != pdPASS);
+        while (xQueueReceive(receiver_queue.get(), nullptr, WAIT_SLICE_TICKS) != pdPASS);
 
         // After waking, sender has provided data_ptr. Hold mutex to copy and ACK.
-        xSemaphoreTake(mutex, portMAX_DELAY);
+        xSemaphoreTake(mutex.get(), portMAX_DELAY);
         if (data_ptr != nullptr && data_ptr_out != nullptr) {
             memcpy(data_ptr_out, data_ptr, data_len);
         }
-        xQueueSend(sender_queue, nullptr, 0); // Release Sender
+        xQueueSend(sender_queue.get(), nullptr, 0); // Release Sender
         reset();
-        xSemaphoreGive(mutex);
+        xSemaphoreGive(mutex.get());
+    }
+}
+
+// --- Extended Input (Receiver) ---
+// Same hand-shake as input(), but the sender is only acknowledged in endExtInput().
+const void* SyncChannel::beginExtInput() {
+    if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return nullptr;
+
+    if (state != SENDER_WAITING) {
+        // No sender present, register as the waiting receiver
+        state = RECEIVER_WAITING;
+        xSemaphoreGive(mutex.get());
+
+        while (xQueueReceive(receiver_queue.get(), nullptr, WAIT_SLICE_TICKS) != pdPASS);
+
+        xSemaphoreTake(mutex.get(), portMAX_DELAY);
+    }
+
+    const void* data = data_ptr;
+    xSemaphoreGive(mutex.get());
+    return data;
+}
+
+void SyncChannel::endExtInput() {
+    xSemaphoreTake(mutex.get(), portMAX_DELAY);
+
+    if (waiting_alt_out != nullptr) {
+        waiting_alt_out->wakeUp(waiting_alt_bit_out);
+    } else {
+        // Release the blocking sender
+        xQueueSend(sender_queue.get(), nullptr, 0);
     }
+
+    reset();
+    xSemaphoreGive(mutex.get());
 }
 
 // =============================================================
@@ -133,10 +144,10 @@ void SyncChannel::input(void* const data_ptr_out) {
 // =============================================================
 
 bool SyncChannel::registerAltIn(AltScheduler* alt, EventBits_t bit, SyncChannelInputGuard* guard) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+    if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return false;
     
     if (state == SENDER_WAITING) { 
-        xSemaphoreGive(mutex); 
+        xSemaphoreGive(mutex.get()); 
         return true; // Already ready for immediate activation
     }
     
@@ -144,23 +155,23 @@ bool SyncChannel::registerAltIn(AltScheduler* alt, EventBits_t bit, SyncChannelI
     waiting_alt_in = alt;
     waiting_alt_bit_in = bit;
     waiting_guard_in = guard;
-    xSemaphoreGive(mutex);
+    xSemaphoreGive(mutex.get());
     return false;
 }
 
 bool SyncChannel::unregisterAltIn(AltScheduler* alt) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+    if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return false;
     bool completed = (state != RECEIVER_WAITING);
     if (!completed && waiting_alt_in == alt) reset();
-    xSemaphoreGive(mutex);
+    xSemaphoreGive(mutex.get());
     return completed;
 }
 
 bool SyncChannel::registerAltOut(AltScheduler* alt, EventBits_t bit, SyncChannelOutputGuard* guard) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+    if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return false;
     
     if (state == RECEIVER_WAITING) { 
-        xSemaphoreGive(mutex); 
+        xSemaphoreGive(mutex.get()); 
         return true; 
     }
     
@@ -168,15 +179,15 @@ bool SyncChannel::registerAltOut(AltScheduler* alt, EventBits_t bit, SyncChannel
     waiting_alt_out = alt;
     waiting_alt_bit_out = bit;
     waiting_guard_out = guard;
-    xSemaphoreGive(mutex);
+    xSemaphoreGive(mutex.get());
     return false;
 }
 
 bool SyncChannel::unregisterAltOut(AltScheduler* alt) {
-    if (xSemaphoreTake(mutex, portMAX_DELAY) != pdTRUE) return false;
+    if (xSemaphoreTake(mutex.get(), portMAX_DELAY) != pdTRUE) return false;
     bool completed = (state != SENDER_WAITING);
     if (!completed && waiting_alt_out == alt) reset();
-    xSemaphoreGive(mutex);
+    xSemaphoreGive(mutex.get());
     return completed;
 }
 
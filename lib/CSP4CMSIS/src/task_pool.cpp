@@ -0,0 +1,96 @@
+// --- task_pool.cpp ---
+
+#include "csp/task_pool.h"
+#include "csp/run.h" // csp::TaskCtx
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+namespace csp::internal {
+
+#if CSP_TASK_POOL_SIZE > 0
+
+namespace {
+    struct PoolWorker {
+        StaticTask_t tcb;
+        StackType_t stack[CSP_TASK_POOL_STACK_WORDS];
+        TaskHandle_t handle;
+        TaskCtx job;                 // Written by dispatch() while the worker is off the free list
+        PoolWorker* next_free;
+    };
+
+    PoolWorker workers[CSP_TASK_POOL_SIZE];
+    PoolWorker* free_list = nullptr;
+    size_t num_created = 0;
+} // namespace
+
+void TaskPool::workerLoop(void* pvParameters) {
+    PoolWorker* self = static_cast<PoolWorker*>(pvParameters);
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        const TaskCtx job = self->job;
+        job.process->run();
+
+        // Back on the free list before the joiner wakes, so a network forked
+        // straight after this one finds the worker idle. The next job may be
+        // written as soon as it is there; this one's semaphore was copied above.
+        taskENTER_CRITICAL();
+        self->next_free = free_list;
+        free_list = self;
+        taskEXIT_CRITICAL();
+
+        xSemaphoreGive(job.completion_sem);
+    }
+}
+
+bool TaskPool::dispatch(CSProcess* process, SemaphoreHandle_t done, UBaseType_t priority) {
+    PoolWorker* w = nullptr;
+    bool create = false;
+
+    taskENTER_CRITICAL();
+    if (free_list != nullptr) {
+        w = free_list;
+        free_list = w->next_free;
+    } else if (num_created < CSP_TASK_POOL_SIZE) {
+        w = &workers[num_created++];
+        create = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (w == nullptr) return false;
+
+    w->job = TaskCtx{ process, done };
+    if (create) {
+        w->handle = xTaskCreateStatic(
+            (TaskFunction_t)workerLoop,
+            "csp_pool",
+            CSP_TASK_POOL_STACK_WORDS,
+            w,
+            priority,
+            w->stack,
+            &w->tcb
+        );
+    } else {
+        vTaskPrioritySet(w->handle, priority);
+    }
+    xTaskNotifyGive(w->handle);
+    return true;
+}
+
+size_t TaskPool::workersCreated() {
+    return num_created;
+}
+
+#else
+
+void TaskPool::workerLoop(void*) {}
+
+bool TaskPool::dispatch(CSProcess*, SemaphoreHandle_t, UBaseType_t) { return false; }
+
+size_t TaskPool::workersCreated() { return 0; }
+
+#endif // CSP_TASK_POOL_SIZE > 0
+
+} // namespace csp::internal
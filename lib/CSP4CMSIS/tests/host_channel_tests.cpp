@@ -0,0 +1,292 @@
+// --- host_channel_tests.cpp ---
+// Regression tests for channel hand-off corner cases, run on the std::thread
+// port (port/host). Each test prints one PASS/FAIL line; the exit status is
+// the number of failures.
+
+#include "csp/csp4cmsis.h"
+#include <cstdio>
+#include <pthread.h>
+#include <sched.h>
+#include <chrono>
+#include <thread>
+
+using namespace csp;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    printf("[%s] %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) failures++;
+}
+
+// =============================================================
+//  Extended input over a timed writer that was already parked
+// =============================================================
+
+// The first writer parks with a short timeout, which expires while the reader
+// is still inside extRead(). It has been committed, so its write must succeed;
+// the second writer, arriving meanwhile, must not be released unread.
+class TimedExtWriter : public CSProcess {
+private:
+    Chanout<int> out;
+public:
+    bool sent = false;
+
+    TimedExtWriter(Chanout<int> w) : out(w) {}
+    void run() override { sent = out.write_for(42, Milliseconds(20)); }
+};
+
+class LateExtWriter : public CSProcess {
+private:
+    Chanout<int> out;
+public:
+    LateExtWriter(Chanout<int> w) : out(w) {}
+    void run() override {
+        vTaskDelay(pdMS_TO_TICKS(40));
+        out << 7;
+    }
+};
+
+class SlowExtReader : public CSProcess {
+private:
+    Chanin<int> in;
+public:
+    int borrowed = 0;
+    int after = 0;
+    bool got_after = false;
+
+    SlowExtReader(Chanin<int> r) : in(r) {}
+    void run() override {
+        vTaskDelay(pdMS_TO_TICKS(5));
+        in.extRead([this](const int& v) {
+            vTaskDelay(pdMS_TO_TICKS(60));
+            borrowed = v;
+        });
+        got_after = in.read_for(after, Milliseconds(200));
+    }
+};
+
+static void testExtReadOfTimedWriter() {
+    static One2OneChannel<int> chan;
+    static TimedExtWriter first(chan.writer());
+    static LateExtWriter second(chan.writer());
+    static SlowExtReader reader(chan.reader());
+
+    Run(InParallel(reader, first, second));
+
+    check(first.sent, "ext read: parked timed writer reports success");
+    check(reader.borrowed == 42, "ext read: borrowed value intact after writer timeout");
+    check(reader.got_after && reader.after == 7, "ext read: later writer not released unread");
+}
+
+// =============================================================
+//  Priority inheritance through two channels at once
+// =============================================================
+
+// The reader (priority 2) is boosted to 5 by a writer blocked on one channel,
+// then to 6 by a writer blocked on another. Completing the first hand-off must
+// leave it at 6, completing the second must bring it back to 2.
+static TaskHandle_t boosted_reader;
+
+static bool waitForPriority(TaskHandle_t task, UBaseType_t priority) {
+    for (int i = 0; i < 500; ++i) {
+        if (uxTaskPriorityGet(task) == priority) return true;
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    return false;
+}
+
+class BoostingWriter : public CSProcess {
+private:
+    Chanout<int> out;
+    UBaseType_t wait_for;   // reader priority to wait for before the blocking write
+public:
+    BoostingWriter(Chanout<int> w, UBaseType_t after) : out(w), wait_for(after) {}
+    void run() override {
+        out << 0;
+        while (boosted_reader == nullptr) vTaskDelay(pdMS_TO_TICKS(1));
+        waitForPriority(boosted_reader, wait_for);
+        out << 1;
+    }
+};
+
+class BoostedReader : public CSProcess {
+private:
+    Chanin<int> in_a;
+    Chanin<int> in_b;
+public:
+    bool reached_top = false;
+    UBaseType_t after_first = 0;
+    UBaseType_t after_second = 0;
+
+    BoostedReader(Chanin<int> a, Chanin<int> b) : in_a(a), in_b(b) {}
+    void run() override {
+        int v;
+        in_a >> v;
+        in_b >> v;
+        boosted_reader = xTaskGetCurrentTaskHandle();
+        reached_top = waitForPriority(nullptr, 6);
+        in_a >> v;
+        after_first = uxTaskPriorityGet(nullptr);
+        in_b >> v;
+        after_second = uxTaskPriorityGet(nullptr);
+    }
+};
+
+static void testOverlappingBoosts() {
+    static One2OneChannel<int> chan_a(InheritPriority);
+    static One2OneChannel<int> chan_b(InheritPriority);
+    static BoostedReader reader(chan_a.reader(), chan_b.reader());
+    static BoostingWriter writer_a(chan_a.writer(), 2);
+    static BoostingWriter writer_b(chan_b.writer(), 5);
+
+    Run(InParallel(Prio<2>(reader), Prio<5>(writer_a), Prio<6>(writer_b)));
+
+    check(reader.reached_top, "inheritance: two boosts raise the reader to 6");
+    check(reader.after_first == 6, "inheritance: first boost ending keeps the higher one");
+    check(reader.after_second == 2, "inheritance: last boost ending restores the base priority");
+}
+
+// =============================================================
+//  Non-blocking reads against a writer that commits as they give up
+// =============================================================
+
+// A writer that takes the reader off the channel notifies it after leaving the
+// critical section. A read that gives up in between must still take that
+// notification, or the reader's next notification wait returns early.
+#define POLL_ROUNDS 2000000
+
+static volatile bool polling_done;
+
+template <typename Out>
+class FloodWriter : public CSProcess {
+private:
+    Out out;
+public:
+    FloodWriter(Out w) : out(w) {}
+    void run() override {
+        for (int i = 0; !polling_done; ++i) out << i;
+    }
+};
+
+// Counts notifications still pending after each poll returned.
+template <typename Poll>
+class PollingReader : public CSProcess {
+private:
+    Poll poll;
+public:
+    uint32_t leftover = 0;
+
+    PollingReader(Poll p) : poll(p) {}
+    void run() override {
+        for (int i = 0; i < POLL_ROUNDS; ++i) {
+            poll();
+            if (ulTaskNotifyTake(pdTRUE, 0) != 0) leftover++;
+        }
+        polling_done = true;
+    }
+};
+
+template <typename Poll>
+static PollingReader<Poll> pollingReader(Poll p) { return PollingReader<Poll>(p); }
+
+static void testLossyTryReadNotification() {
+    static LossyOne2OneChannel<int, 4> chan;
+    static FloodWriter<decltype(chan.writer())> writer(chan.writer());
+    static auto in = chan.reader();
+    static auto reader = pollingReader([] { int v; in.try_read(v); });
+
+    polling_done = false;
+    Run(InParallel(reader, writer));
+
+    check(reader.leftover == 0, "lossy try_read: no notification left behind");
+}
+
+static void testStateReadNewerNotification() {
+    static StateChannel<int> chan;
+    static FloodWriter<decltype(chan.writer())> writer(chan.writer());
+    static auto in = chan.reader();
+    static auto reader = pollingReader([] { int v; in.readNewerFor(v, Milliseconds(0)); });
+
+    polling_done = false;
+    Run(InParallel(reader, writer));
+
+    check(reader.leftover == 0, "state readNewerFor(0): no notification left behind");
+}
+
+// =============================================================
+//  Bucket flushed twice back to back
+// =============================================================
+
+// Fallers run in the idle scheduling class, so the flusher's wake-ups preempt
+// them anywhere, including between leaving the bucket's mutex and starting the
+// wait. A faller caught there by two back-to-back flushes must still be released
+// by the first of them; otherwise it sleeps on (each pair sets and clears its
+// bit before it runs) until the flusher gives up and flushes singly.
+#define BUCKET_FALLERS 4
+#define BUCKET_ROUNDS 2000
+#define BUCKET_DEADLINE_MS 5000
+
+static Bucket bucket;
+static volatile int fallers_done;
+
+class Faller : public CSProcess {
+public:
+    void run() override {
+        int policy;
+        sched_param saved, idle = {};
+        pthread_getschedparam(pthread_self(), &policy, &saved);
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &idle);
+
+        for (int i = 0; i < BUCKET_ROUNDS; ++i) bucket.fallInto();
+
+        pthread_setschedparam(pthread_self(), policy, &saved);
+        taskENTER_CRITICAL();
+        fallers_done = fallers_done + 1;
+        taskEXIT_CRITICAL();
+    }
+};
+
+class DoubleFlusher : public CSProcess {
+public:
+    long released = 0;
+    bool in_time = false;
+
+    void run() override {
+        const TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(BUCKET_DEADLINE_MS);
+        while (fallers_done < BUCKET_FALLERS && xTaskGetTickCount() < deadline) {
+            released += (long)bucket.flush();
+            released += (long)bucket.flush();
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+        in_time = fallers_done == BUCKET_FALLERS;
+
+        // Free any faller left behind
+        while (fallers_done < BUCKET_FALLERS) {
+            released += (long)bucket.flush();
+            vTaskDelay(pdMS_TO_TICKS(1));
+        }
+    }
+};
+
+static void testBucketDoubleFlush() {
+    static Faller fallers[BUCKET_FALLERS];
+    static DoubleFlusher flusher;
+
+    Run(InParallel(flusher, fallers[0], fallers[1], fallers[2], fallers[3]));
+
+    check(flusher.in_time, "bucket: no faller misses a pair of back-to-back flushes");
+    check(flusher.released == (long)BUCKET_FALLERS * BUCKET_ROUNDS,
+          "bucket: back-to-back flushes release each fall exactly once");
+}
+
+// =============================================================
+
+int main() {
+    testExtReadOfTimedWriter();
+    testOverlappingBoosts();
+    testLossyTryReadNotification();
+    testStateReadNewerNotification();
+    testBucketDoubleFlush();
+    return failures;
+}